@@ -0,0 +1,196 @@
+//Antoni Antoszek
+#ifndef FILTRACJA_H
+#define FILTRACJA_H
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <vector>
+#include "KolumnaRzadka.h"
+#include "Kompleks.h"
+
+namespace algebra {
+    // Simplicial complex whose simplices are kept in filtration (insertion) order.
+    // A simplex is stored as its sorted vertex list and its dimension is the
+    // number of vertices minus one; every face must be inserted before the simplex.
+    template<class S>
+    class Filtracja {
+    private:
+        std::vector<std::vector<S>> simplices_;
+        std::map<std::vector<S>, std::size_t> indices_;
+        std::vector<std::size_t> counts_;
+
+        static std::vector<S> canonical(std::vector<S> vertices) {
+            if (vertices.empty()) {
+                throw std::invalid_argument("Simplex must have at least one vertex");
+            }
+            std::sort(vertices.begin(), vertices.end());
+            if (std::adjacent_find(vertices.begin(), vertices.end()) != vertices.end()) {
+                throw std::invalid_argument("Simplex vertices must be distinct");
+            }
+            return vertices;
+        }
+
+        std::size_t insert(std::vector<S> vertices) {
+            std::size_t index = simplices_.size();
+            unsigned dimension = vertices.size() - 1;
+            if (counts_.size() <= dimension) {
+                counts_.resize(dimension + 1, 0);
+            }
+            ++counts_[dimension];
+            indices_.emplace(vertices, index);
+            simplices_.push_back(std::move(vertices));
+            return index;
+        }
+
+    public:
+        // Constructors
+        Filtracja() = default;
+
+        // Getters
+        std::size_t size() const { return simplices_.size(); }
+
+        const std::vector<S>& getSimplex(std::size_t index) const {
+            if (index >= simplices_.size()) {
+                throw std::out_of_range("Simplex index out of bounds");
+            }
+            return simplices_[index];
+        }
+
+        unsigned getDimension(std::size_t index) const {
+            return getSimplex(index).size() - 1;
+        }
+
+        unsigned getMaxDimension() const {
+            return counts_.empty() ? 0 : counts_.size() - 1;
+        }
+
+        std::size_t getCount(unsigned dimension) const {
+            return dimension < counts_.size() ? counts_[dimension] : 0;
+        }
+
+        bool contains(const std::vector<S>& vertices) const {
+            return indices_.count(canonical(vertices)) != 0;
+        }
+
+        std::size_t indexOf(const std::vector<S>& vertices) const {
+            auto it = indices_.find(canonical(vertices));
+            if (it == indices_.end()) {
+                throw std::out_of_range("Simplex is not part of the filtration");
+            }
+            return it->second;
+        }
+
+        // Boundary column of a simplex: faces by index, signs from the sorted vertex order
+        template<unsigned p>
+        KolumnaRzadka<p> boundary(std::size_t index) const {
+            const std::vector<S>& simplex = getSimplex(index);
+            if (simplex.size() == 1) {
+                return KolumnaRzadka<p>();
+            }
+
+            ALGEBRA_COUNT(BoundaryFaces, simplex.size());
+            std::vector<std::pair<std::size_t, int>> faces;
+            ALGEBRA_COUNT_ALLOCATION(faces, simplex.size());
+            faces.reserve(simplex.size());
+            std::vector<S> face(simplex.begin() + 1, simplex.end());
+            ALGEBRA_COUNT_BUFFER(face);
+            for (std::size_t i = 0; i < simplex.size(); ++i) {
+                if (i > 0) {
+                    face[i - 1] = simplex[i - 1];
+                }
+                faces.emplace_back(indices_.find(face)->second, i % 2 == 0 ? 1 : -1);
+            }
+            std::sort(faces.begin(), faces.end());
+
+            KolumnaRzadka<p> column;
+            for (const auto& entry : faces) {
+                column.append(entry.first, ZMod<p>(entry.second));
+            }
+            return column;
+        }
+
+        // Setters
+        std::size_t addSimplex(const std::vector<S>& vertices) {
+            std::vector<S> simplex = canonical(vertices);
+            if (indices_.count(simplex) != 0) {
+                throw std::invalid_argument("Simplex is already part of the filtration");
+            }
+            if (simplex.size() > 1) {
+                std::vector<S> face(simplex.begin() + 1, simplex.end());
+                for (std::size_t i = 0; i < simplex.size(); ++i) {
+                    if (i > 0) {
+                        face[i - 1] = simplex[i - 1];
+                    }
+                    if (indices_.count(face) == 0) {
+                        throw std::invalid_argument("Faces must be added before the simplex");
+                    }
+                }
+            }
+            return insert(std::move(simplex));
+        }
+
+        template<unsigned d>
+        std::size_t addSimplex(const Sympleks<S, d>& simplex) {
+            return addSimplex(simplex.getSequence());
+        }
+
+        // Adds the simplex together with all of its missing faces, lowest dimension first
+        std::size_t addClosure(const std::vector<S>& vertices) {
+            std::vector<S> simplex = canonical(vertices);
+            auto existing = indices_.find(simplex);
+            if (existing != indices_.end()) {
+                return existing->second;
+            }
+            if (simplex.size() > 8 * sizeof(unsigned long) - 1) {
+                throw std::length_error("Simplex is too large to close");
+            }
+
+            std::vector<unsigned long> masks;
+            unsigned long full = (1UL << simplex.size()) - 1;
+            for (unsigned long mask = 1; mask < full; ++mask) {
+                masks.push_back(mask);
+            }
+            auto bits = [](unsigned long mask) {
+                unsigned count = 0;
+                for (; mask != 0; mask &= mask - 1) {
+                    ++count;
+                }
+                return count;
+            };
+            std::stable_sort(masks.begin(), masks.end(), [&bits](unsigned long a, unsigned long b) {
+                return bits(a) < bits(b);
+            });
+
+            std::vector<S> face;
+            for (unsigned long mask : masks) {
+                face.clear();
+                for (std::size_t i = 0; i < simplex.size(); ++i) {
+                    if (mask & (1UL << i)) {
+                        face.push_back(simplex[i]);
+                    }
+                }
+                if (indices_.count(face) == 0) {
+                    insert(face);
+                }
+            }
+            return insert(std::move(simplex));
+        }
+
+        // Adds the closure of every simplex in the support of the chain
+        template<unsigned d, unsigned p>
+        void addKompleks(const Kompleks<S, d, p>& chain) {
+            for (const auto& simplex : chain.getGenerators()) {
+                addClosure(simplex.getSequence());
+            }
+        }
+
+        void clear() {
+            simplices_.clear();
+            indices_.clear();
+            counts_.clear();
+        }
+    };
+}
+
+#endif //FILTRACJA_H
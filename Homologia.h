@@ -0,0 +1,181 @@
+//Antoni Antoszek
+#ifndef HOMOLOGIA_H
+#define HOMOLOGIA_H
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "Filtracja.h"
+#include "MacierzZredukowana.h"
+
+namespace algebra {
+    // Homology over ZMod<p> (p prime) of a filtered complex, reduced in memory.
+    // Representative cycles are opt-in: only the reduction columns of the requested
+    // dimensions are tracked, sparsely, and dropped as soon as they cannot be needed.
+    template<class S, unsigned p>
+    class Homologia {
+        static_assert(p > 1, "Homology is computed over the field ZMod<p>, p prime");
+
+    public:
+        static constexpr std::size_t NONE = MacierzZredukowana<p>::NONE;
+
+        // Persistence bar [birth, death) of a class in the given dimension;
+        // death is NONE for classes that survive the whole filtration
+        struct Przedzial {
+            std::size_t birth;
+            std::size_t death;
+            unsigned dimension;
+        };
+
+    private:
+        Filtracja<S> filtration_;
+        MacierzZredukowana<p> reduced_;
+        std::vector<unsigned> betti_;
+        std::vector<unsigned> cycle_dimensions_;
+        std::unordered_map<std::size_t, KolumnaRzadka<p>> cycles_;
+        std::size_t cycles_bytes_;
+        std::size_t peak_cycles_bytes_;
+
+        bool tracks(unsigned dimension) const {
+            return std::find(cycle_dimensions_.begin(), cycle_dimensions_.end(), dimension)
+                != cycle_dimensions_.end();
+        }
+
+        void dropCycle(std::size_t index) {
+            auto it = cycles_.find(index);
+            if (it != cycles_.end()) {
+                cycles_bytes_ -= it->second.getMemoryUsage();
+                cycles_.erase(it);
+            }
+        }
+
+        void reduce() {
+            ALGEBRA_SCOPED_TIMER("Homologia::reduce");
+            betti_.assign(filtration_.getMaxDimension() + 1, 0);
+            for (std::size_t j = 0; j < filtration_.size(); ++j) {
+                unsigned dimension = filtration_.getDimension(j);
+                if (tracks(dimension)) {
+                    KolumnaRzadka<p> cycle;
+                    cycle.append(j, ZMod<p>(1));
+                    reduced_.addColumn(filtration_.template boundary<p>(j),
+                        [this, &cycle](std::size_t owner, const ZMod<p>& factor) {
+                            cycle.addMultiple(cycles_.at(owner), factor);
+                        });
+                    cycle.shrink();
+                    cycles_bytes_ += cycle.getMemoryUsage();
+                    cycles_.emplace(j, std::move(cycle));
+                    peak_cycles_bytes_ = std::max(peak_cycles_bytes_, cycles_bytes_);
+                } else {
+                    reduced_.addColumn(filtration_.template boundary<p>(j));
+                }
+
+                if (reduced_.getColumn(j).empty()) {
+                    ++betti_[dimension];
+                } else {
+                    --betti_[dimension - 1];
+                    // A finite bar is represented by the reduced column that kills it
+                    dropCycle(reduced_.getColumn(j).pivot());
+                }
+            }
+
+            // Only cycles of classes that never die are kept
+            for (std::size_t j = 0; j < filtration_.size(); ++j) {
+                if (!reduced_.getColumn(j).empty()) {
+                    dropCycle(j);
+                }
+            }
+        }
+
+    public:
+        // Constructors
+        explicit Homologia(Filtracja<S> filtration)
+            : filtration_(std::move(filtration)), cycles_bytes_(0), peak_cycles_bytes_(0) {
+            reduce();
+        }
+
+        // Also tracks what is needed for representative cycles in the given dimensions
+        Homologia(Filtracja<S> filtration, std::vector<unsigned> cycle_dimensions)
+            : filtration_(std::move(filtration)), cycle_dimensions_(std::move(cycle_dimensions)),
+              cycles_bytes_(0), peak_cycles_bytes_(0) {
+            reduce();
+        }
+
+        // Getters
+        const Filtracja<S>& getFiltration() const { return filtration_; }
+        const MacierzZredukowana<p>& getReducedMatrix() const { return reduced_; }
+
+        const std::vector<unsigned>& getBettiNumbers() const { return betti_; }
+
+        unsigned getBettiNumber(unsigned dimension) const {
+            return dimension < betti_.size() ? betti_[dimension] : 0;
+        }
+
+        std::size_t getMemoryUsage() const { return reduced_.getMemoryUsage() + cycles_bytes_; }
+
+        // Bytes spent on representative tracking, now and at its peak during reduction
+        std::size_t getCycleMemoryUsage() const { return cycles_bytes_; }
+        std::size_t getPeakCycleMemoryUsage() const { return peak_cycles_bytes_; }
+
+        std::vector<Przedzial> getPersistencePairs() const {
+            std::vector<Przedzial> bars;
+            for (std::size_t j = 0; j < filtration_.size(); ++j) {
+                const KolumnaRzadka<p>& column = reduced_.getColumn(j);
+                if (!column.empty()) {
+                    bars.push_back({column.pivot(), j, filtration_.getDimension(j) - 1});
+                } else if (reduced_.getPivotOwner(j) == NONE) {
+                    bars.push_back({j, NONE, filtration_.getDimension(j)});
+                }
+            }
+            std::sort(bars.begin(), bars.end(), [](const Przedzial& a, const Przedzial& b) {
+                return a.birth < b.birth;
+            });
+            return bars;
+        }
+
+        // Cycle born at the given simplex, as a column over simplex indices
+        KolumnaRzadka<p> getRepresentative(std::size_t birth) const {
+            if (!reduced_.getColumn(birth).empty()) {
+                throw std::invalid_argument("Simplex does not create a homology class");
+            }
+            std::size_t death = reduced_.getPivotOwner(birth);
+            if (death != NONE) {
+                return reduced_.getColumn(death);
+            }
+            auto it = cycles_.find(birth);
+            if (it == cycles_.end()) {
+                throw std::logic_error("Representatives of this dimension were not requested");
+            }
+            return it->second;
+        }
+
+        // Chain of d-vertex simplices in sorted vertex orientation
+        template<unsigned d>
+        Kompleks<S, d, p> toKompleks(const KolumnaRzadka<p>& column) const {
+            std::vector<Sympleks<S, d>> generators;
+            generators.reserve(column.size());
+            for (std::size_t row : column.getRows()) {
+                const std::vector<S>& simplex = filtration_.getSimplex(row);
+                if (simplex.size() != d) {
+                    throw std::invalid_argument("Chain dimension does not match the simplices");
+                }
+                generators.push_back(Sympleks<S, d>(simplex.data()));
+            }
+            return Kompleks<S, d, p>(generators, column.getValues());
+        }
+
+        // Basis of H_{d-1}: one cycle of d-vertex simplices per surviving class
+        template<unsigned d>
+        std::vector<Kompleks<S, d, p>> getRepresentativeCycles() const {
+            std::vector<Kompleks<S, d, p>> result;
+            for (const Przedzial& bar : getPersistencePairs()) {
+                if (bar.death == NONE && bar.dimension + 1 == d) {
+                    result.push_back(toKompleks<d>(getRepresentative(bar.birth)));
+                }
+            }
+            return result;
+        }
+    };
+}
+
+#endif //HOMOLOGIA_H
@@ -0,0 +1,136 @@
+//Antoni Antoszek
+#ifndef HOMOLOGIAPRZYROSTOWA_H
+#define HOMOLOGIAPRZYROSTOWA_H
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Filtracja.h"
+#include "MacierzZredukowana.h"
+
+namespace algebra {
+    // Homology over ZMod<p> (p prime) kept up to date while simplices are appended
+    // in filtration order. Vertices and edges are handled by union-find over the
+    // vertices; simplices of dimension >= 2 are reduced once against a persistent
+    // reduced matrix, so each update costs only the reduction of the new columns.
+    // Vertices and edges hold empty placeholder columns in that matrix, so it is
+    // internal; use Homologia for the reduced matrix and representatives.
+    template<class S, unsigned p>
+    class HomologiaPrzyrostowa {
+        static_assert(p > 1, "Homology is computed over the field ZMod<p>, p prime");
+
+    private:
+        Filtracja<S> filtration_;
+        MacierzZredukowana<p> reduced_;
+        std::unordered_map<std::size_t, std::size_t> vertex_ids_;
+        std::vector<std::size_t> parents_;
+        std::vector<std::size_t> sizes_;
+        std::vector<unsigned> betti_;
+
+        std::size_t find(std::size_t vertex) {
+            while (parents_[vertex] != vertex) {
+                parents_[vertex] = parents_[parents_[vertex]];
+                vertex = parents_[vertex];
+            }
+            return vertex;
+        }
+
+        // Returns false when both vertices already lie in one component
+        bool unite(std::size_t a, std::size_t b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            if (sizes_[a] < sizes_[b]) {
+                std::swap(a, b);
+            }
+            parents_[b] = a;
+            sizes_[a] += sizes_[b];
+            return true;
+        }
+
+        // Processes the simplices appended to the filtration since the last update
+        void update() {
+            for (std::size_t j = reduced_.size(); j < filtration_.size(); ++j) {
+                unsigned dimension = filtration_.getDimension(j);
+                if (betti_.size() <= dimension) {
+                    betti_.resize(dimension + 1, 0);
+                }
+                if (dimension == 0) {
+                    vertex_ids_.emplace(j, parents_.size());
+                    parents_.push_back(parents_.size());
+                    sizes_.push_back(1);
+                    reduced_.addColumn(KolumnaRzadka<p>());
+                    ++betti_[0];
+                } else if (dimension == 1) {
+                    KolumnaRzadka<p> ends = filtration_.template boundary<p>(j);
+                    reduced_.addColumn(KolumnaRzadka<p>());
+                    if (unite(vertex_ids_.at(ends.getRows()[0]), vertex_ids_.at(ends.getRows()[1]))) {
+                        --betti_[0];
+                    } else {
+                        ++betti_[1];
+                    }
+                } else {
+                    reduced_.addColumn(filtration_.template boundary<p>(j));
+                    if (reduced_.getColumn(j).empty()) {
+                        ++betti_[dimension];
+                    } else {
+                        --betti_[dimension - 1];
+                    }
+                }
+            }
+        }
+
+    public:
+        // Constructors
+        HomologiaPrzyrostowa() = default;
+
+        explicit HomologiaPrzyrostowa(Filtracja<S> filtration) : filtration_(std::move(filtration)) {
+            update();
+        }
+
+        // Getters
+        const Filtracja<S>& getFiltration() const { return filtration_; }
+
+        const std::vector<unsigned>& getBettiNumbers() const { return betti_; }
+
+        unsigned getBettiNumber(unsigned dimension) const {
+            return dimension < betti_.size() ? betti_[dimension] : 0;
+        }
+
+        std::size_t getMemoryUsage() const {
+            return reduced_.getMemoryUsage()
+                + (parents_.capacity() + sizes_.capacity()) * sizeof(std::size_t)
+                + vertex_ids_.bucket_count() * sizeof(void*)
+                + vertex_ids_.size() * (2 * sizeof(std::size_t) + sizeof(void*));
+        }
+
+        // Setters
+        // Faces must already be present; throws std::invalid_argument otherwise
+        std::size_t addSimplex(const std::vector<S>& vertices) {
+            std::size_t index = filtration_.addSimplex(vertices);
+            update();
+            return index;
+        }
+
+        template<unsigned d>
+        std::size_t addSimplex(const Sympleks<S, d>& simplex) {
+            return addSimplex(simplex.getSequence());
+        }
+
+        std::size_t addClosure(const std::vector<S>& vertices) {
+            std::size_t index = filtration_.addClosure(vertices);
+            update();
+            return index;
+        }
+
+        template<unsigned d, unsigned q>
+        void addKompleks(const Kompleks<S, d, q>& chain) {
+            filtration_.addKompleks(chain);
+            update();
+        }
+    };
+}
+
+#endif //HOMOLOGIAPRZYROSTOWA_H
@@ -0,0 +1,512 @@
+//Antoni Antoszek
+#ifndef HOMOLOGIAZEWNETRZNA_H
+#define HOMOLOGIAZEWNETRZNA_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/types.h>
+#endif
+#include "Filtracja.h"
+#include "MacierzZredukowana.h"
+
+namespace algebra {
+    // Homology over ZMod<p> (p prime) computed out of core. Boundary columns are
+    // read from a streaming source and reduced in blocks; reduced columns and pivots
+    // are spilled to temporary files. Everything the engine allocates (current block,
+    // cache of spilled columns, column being reduced, the containers holding them at
+    // their capacity and bucket counts, I/O and stdio buffers) is charged before it is
+    // allocated and never exceeds the memory budget; only the C library's FILE objects
+    // are outside it. Produces the same reduced matrix as Homologia<S, p>.
+    template<class S, unsigned p>
+    class HomologiaZewnetrzna {
+        static_assert(p > 1, "Homology is computed over the field ZMod<p>, p prime");
+
+    public:
+        static constexpr std::size_t NONE = MacierzZredukowana<p>::NONE;
+
+        // Streaming input: stores the boundary column and dimension of the next simplex
+        // in filtration order and returns true, or returns false once the input ends
+        using ZrodloKolumn = std::function<bool(KolumnaRzadka<p>&, unsigned&)>;
+
+    private:
+        struct FileCloser {
+            void operator()(std::FILE* file) const {
+                if (file != nullptr) {
+                    std::fclose(file);
+                }
+            }
+        };
+        using File = std::unique_ptr<std::FILE, FileCloser>;
+
+        struct IndexEntry {
+            std::uint64_t offset;
+            std::uint64_t length;
+        };
+
+        using Pivots = std::unordered_map<std::size_t, std::size_t>;
+        using CacheOrder = std::list<std::size_t>;
+        using Cache = std::unordered_map<std::size_t, std::pair<KolumnaRzadka<p>, CacheOrder::iterator>>;
+
+        // Heap bytes of one column entry
+        static constexpr std::size_t ENTRY_BYTES = sizeof(std::size_t) + sizeof(ZMod<p>);
+        // Upper bounds on a node of the pivot map and on a cache entry (map node and
+        // LRU list node), links and cached hash included
+        static constexpr std::size_t PIVOT_NODE = sizeof(typename Pivots::value_type) + 2 * sizeof(void*);
+        static constexpr std::size_t CACHE_NODE = sizeof(typename Cache::value_type) + 2 * sizeof(void*)
+            + sizeof(std::size_t) + 2 * sizeof(void*);
+        // Buffer through which spilled columns are converted, and the stdio buffer of each file
+        static constexpr std::size_t IO_BUFFER_SIZE = 16 * sizeof(std::uint64_t);
+        static constexpr std::size_t FILE_BUFFER_SIZE = 128;
+        static constexpr std::size_t FILES = 3;
+        static constexpr std::size_t INITIAL_BUCKETS = 8;
+
+        std::size_t budget_;
+        std::vector<char> file_buffers_;
+        File columns_file_;
+        File index_file_;
+        File pivots_file_;
+        std::uint64_t columns_end_;
+        std::size_t flushed_;
+
+        std::vector<KolumnaRzadka<p>> block_;
+        Pivots block_pivots_;
+        std::size_t block_bytes_;
+
+        CacheOrder cache_order_;
+        Cache cache_;
+        std::size_t cache_bytes_;
+
+        std::size_t largest_input_;
+
+        std::size_t peak_bytes_;
+        std::size_t block_count_;
+        std::vector<unsigned> betti_;
+        mutable std::vector<unsigned char> io_buffer_;
+
+        // The stdio buffer is owned and charged by the engine instead of the C library
+        static File openTemporary(char* buffer) {
+            File file(std::tmpfile());
+            if (!file) {
+                throw std::runtime_error("Cannot create temporary file");
+            }
+            if (std::setvbuf(file.get(), buffer, _IOFBF, FILE_BUFFER_SIZE) != 0) {
+                throw std::runtime_error("Cannot buffer temporary file");
+            }
+            return file;
+        }
+
+        // Offsets are 64-bit, so spill files may grow past 2 GiB
+        static void seek(std::FILE* file, std::uint64_t offset) {
+#if defined(_WIN32)
+            int status = _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+            static_assert(sizeof(off_t) >= sizeof(std::uint64_t), "Define _FILE_OFFSET_BITS=64 for 64-bit file offsets");
+            int status = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+            if (status != 0) {
+                throw std::runtime_error("Cannot seek in temporary file");
+            }
+        }
+
+        static void writeAt(std::FILE* file, std::uint64_t offset, const void* data, std::size_t bytes) {
+            seek(file, offset);
+            if (std::fwrite(data, 1, bytes, file) != bytes) {
+                throw std::runtime_error("Cannot write temporary file");
+            }
+        }
+
+        static void readAt(std::FILE* file, std::uint64_t offset, void* data, std::size_t bytes) {
+            seek(file, offset);
+            if (std::fread(data, 1, bytes, file) != bytes) {
+                throw std::runtime_error("Cannot read temporary file");
+            }
+        }
+
+        // Reads `count` records of `size` bytes from the current position through the
+        // I/O buffer, passing each to consume(record)
+        template<class F>
+        void readRecords(std::FILE* file, std::uint64_t count, std::size_t size, F&& consume) const {
+            const std::size_t per_chunk = IO_BUFFER_SIZE / size;
+            while (count > 0) {
+                std::size_t records = static_cast<std::size_t>(std::min<std::uint64_t>(count, per_chunk));
+                if (std::fread(io_buffer_.data(), size, records, file) != records) {
+                    throw std::runtime_error("Cannot read temporary file");
+                }
+                for (std::size_t i = 0; i < records; ++i) {
+                    consume(io_buffer_.data() + i * size);
+                }
+                count -= records;
+            }
+        }
+
+        // Writes `count` records of `size` bytes at the current position through the
+        // I/O buffer, filling record i with produce(i, record)
+        template<class F>
+        void writeRecords(std::FILE* file, std::size_t count, std::size_t size, F&& produce) const {
+            const std::size_t per_chunk = IO_BUFFER_SIZE / size;
+            for (std::size_t first = 0; first < count; first += per_chunk) {
+                std::size_t records = std::min(count - first, per_chunk);
+                for (std::size_t i = 0; i < records; ++i) {
+                    produce(first + i, io_buffer_.data() + i * size);
+                }
+                if (std::fwrite(io_buffer_.data(), size, records, file) != records) {
+                    throw std::runtime_error("Cannot write temporary file");
+                }
+            }
+        }
+
+        std::size_t blockStart() const { return flushed_; }
+
+        std::size_t blockBytes() const {
+            return block_.capacity() * sizeof(KolumnaRzadka<p>) + block_bytes_
+                + block_pivots_.size() * PIVOT_NODE + block_pivots_.bucket_count() * sizeof(void*);
+        }
+
+        // Heap bytes held by the engine plus `working` bytes about to be allocated
+        std::size_t resident(std::size_t working) const {
+            return IO_BUFFER_SIZE + FILES * FILE_BUFFER_SIZE + betti_.capacity() * sizeof(unsigned)
+                + blockBytes() + cache_bytes_ + cache_.size() * CACHE_NODE
+                + cache_.bucket_count() * sizeof(void*) + working;
+        }
+
+        // Hash maps are grown explicitly before an insertion would rehash them, so the
+        // old and new bucket arrays are charged while both are alive. reserve(n) rounds
+        // the bucket count up to a prime, at most doubling it.
+        template<class M>
+        static bool needsRehash(const M& map) {
+            return map.size() + 1 > map.bucket_count() * map.max_load_factor();
+        }
+
+        template<class M>
+        static std::size_t rehashBytes(const M& map) {
+            if (!needsRehash(map)) {
+                return 0;
+            }
+            double buckets = 2 * (map.size() + 1) / map.max_load_factor();
+            return 2 * (static_cast<std::size_t>(buckets) + 1) * sizeof(void*);
+        }
+
+        template<class M>
+        static void grow(M& map) {
+            if (needsRehash(map)) {
+                map.reserve(2 * (map.size() + 1));
+            }
+        }
+
+        void track(std::size_t working) {
+            if (resident(working) > peak_bytes_) {
+                peak_bytes_ = resident(working);
+            }
+        }
+
+        void evictOne() {
+            std::size_t victim = cache_order_.back();
+            cache_order_.pop_back();
+            auto it = cache_.find(victim);
+            cache_bytes_ -= it->second.first.getMemoryUsage();
+            cache_.erase(it);
+        }
+
+        bool evictable(std::size_t pinned) const {
+            return !cache_order_.empty() && cache_order_.back() != pinned;
+        }
+
+        // Frees cache and, if needed, the current block until `working` more bytes fit;
+        // the cached column `pinned` is kept
+        void ensureBudget(std::size_t working, std::size_t pinned = NONE) {
+            while (resident(working) > budget_ && evictable(pinned)) {
+                evictOne();
+            }
+            if (resident(working) > budget_ && !block_.empty()) {
+                flush();
+                while (resident(working) > budget_ && evictable(pinned)) {
+                    evictOne();
+                }
+            }
+            if (resident(working) > budget_) {
+                throw std::length_error("Column does not fit in the memory budget");
+            }
+            track(working);
+        }
+
+        void cache(std::size_t index, KolumnaRzadka<p> column) {
+            cache_bytes_ += column.getMemoryUsage();
+            cache_order_.push_front(index);
+            cache_.emplace(index, std::make_pair(std::move(column), cache_order_.begin()));
+        }
+
+        std::size_t pivotOwner(std::size_t row) {
+            auto local = block_pivots_.find(row);
+            if (local != block_pivots_.end()) {
+                return local->second;
+            }
+            return getPivotOwner(row);
+        }
+
+        IndexEntry indexEntry(std::size_t index) const {
+            IndexEntry entry;
+            readAt(index_file_.get(), index * sizeof(IndexEntry), &entry, sizeof(entry));
+            return entry;
+        }
+
+        KolumnaRzadka<p> load(const IndexEntry& entry) const {
+            std::vector<std::size_t> rows;
+            std::vector<ZMod<p>> values;
+            rows.reserve(entry.length);
+            values.reserve(entry.length);
+
+            seek(columns_file_.get(), entry.offset);
+            readRecords(columns_file_.get(), entry.length, sizeof(std::uint64_t), [&rows](const unsigned char* record) {
+                std::uint64_t row;
+                std::memcpy(&row, record, sizeof(row));
+                rows.push_back(static_cast<std::size_t>(row));
+            });
+            readRecords(columns_file_.get(), entry.length, sizeof(std::uint32_t), [&values](const unsigned char* record) {
+                std::uint32_t value;
+                std::memcpy(&value, record, sizeof(value));
+                values.push_back(ZMod<p>(static_cast<int>(value)));
+            });
+            return KolumnaRzadka<p>(std::move(rows), std::move(values));
+        }
+
+        std::size_t columnLength(std::size_t index) const {
+            if (index >= blockStart()) {
+                return block_[index - blockStart()].size();
+            }
+            auto it = cache_.find(index);
+            if (it != cache_.end()) {
+                return it->second.first.size();
+            }
+            return static_cast<std::size_t>(indexEntry(index).length);
+        }
+
+        // Reduced column `index`, from the current block, the cache or disk. Room for
+        // `working` more bytes is made first, so the returned column stays resident.
+        // Records are converted through the I/O buffer, so a column loaded from disk
+        // costs only its own entries.
+        const KolumnaRzadka<p>& fetch(std::size_t index, std::size_t working) {
+            if (index >= blockStart()) {
+                ensureBudget(working);
+                if (index >= blockStart()) {
+                    return block_[index - blockStart()];
+                }
+            }
+            auto it = cache_.find(index);
+            if (it != cache_.end()) {
+                cache_order_.splice(cache_order_.begin(), cache_order_, it->second.second);
+                ensureBudget(working, index);
+                return it->second.first;
+            }
+
+            IndexEntry entry = indexEntry(index);
+            ensureBudget(working + static_cast<std::size_t>(entry.length) * ENTRY_BYTES + CACHE_NODE
+                + rehashBytes(cache_));
+            grow(cache_);
+            cache(index, load(entry));
+            return cache_.find(index)->second.first;
+        }
+
+        // Bytes allocated by appending a column to the block; growing block_ or
+        // rehashing block_pivots_ keeps the old and the new buffer alive at once
+        std::size_t blockGrowth(bool pivot) const {
+            std::size_t slots = block_.size() == block_.capacity()
+                ? std::max<std::size_t>(1, 2 * block_.capacity()) : 0;
+            return slots * sizeof(KolumnaRzadka<p>) + (pivot ? PIVOT_NODE + rehashBytes(block_pivots_) : 0);
+        }
+
+        // Makes room to append a column of `working` bytes to the block, starting a
+        // new block when the current one cannot grow within the budget
+        void reserveBlock(std::size_t working, bool pivot) {
+            while (resident(working + blockGrowth(pivot)) > budget_ && evictable(NONE)) {
+                evictOne();
+            }
+            if (resident(working + blockGrowth(pivot)) > budget_) {
+                flush();
+            }
+            ensureBudget(working + blockGrowth(pivot));
+
+            if (block_.size() == block_.capacity()) {
+                block_.reserve(std::max<std::size_t>(1, 2 * block_.capacity()));
+            }
+            if (pivot) {
+                grow(block_pivots_);
+            }
+        }
+
+        void flush() {
+            if (block_.empty()) {
+                return;
+            }
+            ALGEBRA_SCOPED_TIMER("HomologiaZewnetrzna::flush");
+            const std::uint64_t none = static_cast<std::uint64_t>(-1);
+
+            for (std::size_t k = 0; k < block_.size(); ++k) {
+                std::size_t index = blockStart() + k;
+                const KolumnaRzadka<p>& column = block_[k];
+                const auto& rows = column.getRows();
+                const auto& values = column.getValues();
+
+                IndexEntry entry{columns_end_, column.size()};
+                seek(columns_file_.get(), columns_end_);
+                writeRecords(columns_file_.get(), rows.size(), sizeof(std::uint64_t), [&rows](std::size_t i, unsigned char* record) {
+                    std::uint64_t row = rows[i];
+                    std::memcpy(record, &row, sizeof(row));
+                });
+                writeRecords(columns_file_.get(), values.size(), sizeof(std::uint32_t), [&values](std::size_t i, unsigned char* record) {
+                    std::uint32_t value = static_cast<std::uint32_t>(values[i].getValue());
+                    std::memcpy(record, &value, sizeof(value));
+                });
+                columns_end_ += rows.size() * (sizeof(std::uint64_t) + sizeof(std::uint32_t));
+
+                writeAt(index_file_.get(), index * sizeof(IndexEntry), &entry, sizeof(entry));
+                writeAt(pivots_file_.get(), index * sizeof(none), &none, sizeof(none));
+            }
+            for (const auto& pivot : block_pivots_) {
+                std::uint64_t owner = pivot.second;
+                writeAt(pivots_file_.get(), pivot.first * sizeof(owner), &owner, sizeof(owner));
+            }
+
+            flushed_ += block_.size();
+            block_.clear();
+            block_.shrink_to_fit();
+            block_pivots_.clear();
+            block_bytes_ = 0;
+            ++block_count_;
+        }
+
+        static ZrodloKolumn columnsOf(const Filtracja<S>& filtration) {
+            std::size_t next = 0;
+            return [&filtration, next](KolumnaRzadka<p>& column, unsigned& dimension) mutable {
+                if (next == filtration.size()) {
+                    return false;
+                }
+                column = filtration.template boundary<p>(next);
+                dimension = filtration.getDimension(next);
+                ++next;
+                return true;
+            };
+        }
+
+        void reduce(const ZrodloKolumn& source) {
+            ALGEBRA_SCOPED_TIMER("HomologiaZewnetrzna::reduce");
+            KolumnaRzadka<p> column;
+            unsigned dimension;
+            for (std::size_t j = 0;; ++j) {
+                // Room for the next input column and its growth while the source fills it
+                ensureBudget(2 * largest_input_);
+                if (!source(column, dimension)) {
+                    break;
+                }
+                largest_input_ = std::max(largest_input_, column.getMemoryUsage());
+                if (!column.empty() && (column.pivot() >= j || dimension == 0)) {
+                    throw std::invalid_argument("Boundary column must refer to earlier simplices");
+                }
+                if (betti_.size() <= dimension) {
+                    ensureBudget(column.getMemoryUsage() + (dimension + 1) * sizeof(unsigned));
+                    betti_.reserve(dimension + 1);
+                    betti_.resize(dimension + 1, 0);
+                }
+                ensureBudget(column.getMemoryUsage());
+                while (!column.empty()) {
+                    std::size_t owner = pivotOwner(column.pivot());
+                    if (owner == NONE) {
+                        break;
+                    }
+                    // addMultiple builds the sum in new buffers while the column is alive
+                    std::size_t merged = (column.size() + columnLength(owner)) * ENTRY_BYTES;
+                    const KolumnaRzadka<p>& other = fetch(owner, column.getMemoryUsage() + merged);
+                    column.addMultiple(other, column.eliminationFactor(other));
+                    ALGEBRA_COUNT(ColumnAdditions, 1);
+                }
+
+                // shrink() copies the entries into buffers of the exact size
+                ensureBudget(column.getMemoryUsage() + column.size() * ENTRY_BYTES);
+                column.shrink();
+                reserveBlock(column.getMemoryUsage(), !column.empty());
+                if (column.empty()) {
+                    ++betti_[dimension];
+                } else {
+                    --betti_[dimension - 1];
+                    block_pivots_.emplace(column.pivot(), j);
+                }
+                block_bytes_ += column.getMemoryUsage();
+                block_.push_back(std::move(column));
+                column = KolumnaRzadka<p>();
+                if (blockBytes() > budget_ / 2) {
+                    flush();
+                }
+            }
+            flush();
+        }
+
+    public:
+        // Constructors
+        // Only the source's own state is outside the budget, so a source that computes
+        // face indices on the fly keeps the whole computation within it
+        HomologiaZewnetrzna(const ZrodloKolumn& source, std::size_t memory_budget)
+            : budget_(memory_budget), file_buffers_(FILES * FILE_BUFFER_SIZE),
+              columns_file_(openTemporary(file_buffers_.data())),
+              index_file_(openTemporary(file_buffers_.data() + FILE_BUFFER_SIZE)),
+              pivots_file_(openTemporary(file_buffers_.data() + 2 * FILE_BUFFER_SIZE)),
+              columns_end_(0), flushed_(0), block_pivots_(INITIAL_BUCKETS), block_bytes_(0),
+              cache_(INITIAL_BUCKETS), cache_bytes_(0), largest_input_(0), peak_bytes_(0),
+              block_count_(0), io_buffer_(IO_BUFFER_SIZE) {
+            if (memory_budget == 0) {
+                throw std::invalid_argument("Memory budget must be positive");
+            }
+            reduce(source);
+        }
+
+        // Convenience for complexes that fit in memory: the filtration itself stays
+        // resident and is not counted in the budget
+        HomologiaZewnetrzna(const Filtracja<S>& filtration, std::size_t memory_budget)
+            : HomologiaZewnetrzna(columnsOf(filtration), memory_budget) {}
+
+        HomologiaZewnetrzna(const HomologiaZewnetrzna&) = delete;
+        HomologiaZewnetrzna& operator=(const HomologiaZewnetrzna&) = delete;
+
+        // Getters
+        const std::vector<unsigned>& getBettiNumbers() const { return betti_; }
+
+        unsigned getBettiNumber(unsigned dimension) const {
+            return dimension < betti_.size() ? betti_[dimension] : 0;
+        }
+
+        std::size_t size() const { return flushed_; }
+        std::size_t getMemoryBudget() const { return budget_; }
+        std::size_t getPeakMemoryUsage() const { return peak_bytes_; }
+        std::size_t getBlockCount() const { return block_count_; }
+
+        std::size_t getSpilledBytes() const {
+            return columns_end_ + flushed_ * (sizeof(IndexEntry) + sizeof(std::uint64_t));
+        }
+
+        // Reduced column read back from disk
+        KolumnaRzadka<p> getColumn(std::size_t index) const {
+            if (index >= flushed_) {
+                throw std::out_of_range("Column index out of bounds");
+            }
+            return load(indexEntry(index));
+        }
+
+        std::size_t getPivotOwner(std::size_t row) const {
+            if (row >= flushed_) {
+                return NONE;
+            }
+            std::uint64_t owner;
+            readAt(pivots_file_.get(), row * sizeof(owner), &owner, sizeof(owner));
+            return owner == static_cast<std::uint64_t>(-1) ? NONE : static_cast<std::size_t>(owner);
+        }
+    };
+}
+
+#endif //HOMOLOGIAZEWNETRZNA_H
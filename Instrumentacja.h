@@ -0,0 +1,233 @@
+//Antoni Antoszek
+#ifndef INSTRUMENTACJA_H
+#define INSTRUMENTACJA_H
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Hot-path counters and timers, enabled by defining ALGEBRA_INSTRUMENTATION.
+// Without it ALGEBRA_COUNT, ALGEBRA_COUNT_ALLOCATION, ALGEBRA_COUNT_BUFFER and
+// ALGEBRA_SCOPED_TIMER expand to nothing.
+#ifdef ALGEBRA_INSTRUMENTATION
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define ALGEBRA_CONCAT_IMPL(a, b) a##b
+#define ALGEBRA_CONCAT(a, b) ALGEBRA_CONCAT_IMPL(a, b)
+#define ALGEBRA_COUNT(counter, n) \
+    ::algebra::instrumentacja::count(::algebra::instrumentacja::Licznik::counter, (n))
+// A vector reallocates exactly when it must hold more elements than its capacity:
+// placed before a copy-assignment, reserve or insertion that grows `vector` to
+// `elements` elements, this counts that allocation
+#define ALGEBRA_COUNT_ALLOCATION(vector, elements) \
+    ALGEBRA_COUNT(Allocations, (elements) > (vector).capacity() ? 1 : 0)
+// Placed after `vector` is constructed as a copy or with a size, counts its buffer
+#define ALGEBRA_COUNT_BUFFER(vector) \
+    ALGEBRA_COUNT(Allocations, (vector).empty() ? 0 : 1)
+#define ALGEBRA_SCOPED_TIMER(name) \
+    ::algebra::instrumentacja::ZegarZakresu ALGEBRA_CONCAT(algebra_timer_, __LINE__)(name)
+#else
+#define ALGEBRA_COUNT(counter, n) ((void)0)
+#define ALGEBRA_COUNT_ALLOCATION(vector, elements) ((void)0)
+#define ALGEBRA_COUNT_BUFFER(vector) ((void)0)
+#define ALGEBRA_SCOPED_TIMER(name) ((void)0)
+#endif
+
+namespace algebra {
+    namespace instrumentacja {
+        enum class Licznik : unsigned {
+            NormalizeCalls,     // calls to WolnyModul::normalize()
+            NormalizeSorts,     // calls that actually sorted
+            SortedElements,     // elements passed to those sorts
+            Merges,             // equal generators combined while normalizing
+            Allocations,        // vector buffers allocated by WolnyModul, Sympleks, KolumnaRzadka,
+                                // MacierzZredukowana and boundary scratch buffers
+            BoundaryFaces,      // faces emitted by boundary computations
+            ColumnAdditions,    // column operations during matrix reduction
+            Count
+        };
+
+        inline const char* name(Licznik counter) {
+            switch (counter) {
+                case Licznik::NormalizeCalls: return "normalize_calls";
+                case Licznik::NormalizeSorts: return "normalize_sorts";
+                case Licznik::SortedElements: return "sorted_elements";
+                case Licznik::Merges: return "merges";
+                case Licznik::Allocations: return "allocations";
+                case Licznik::BoundaryFaces: return "boundary_faces";
+                case Licznik::ColumnAdditions: return "column_additions";
+                default: return "unknown";
+            }
+        }
+
+        constexpr bool enabled() {
+#ifdef ALGEBRA_INSTRUMENTATION
+            return true;
+#else
+            return false;
+#endif
+        }
+
+#ifdef ALGEBRA_INSTRUMENTATION
+        constexpr unsigned COUNTERS = static_cast<unsigned>(Licznik::Count);
+
+        struct Czas {
+            std::uint64_t calls = 0;
+            std::uint64_t nanoseconds = 0;
+        };
+
+        // Data of one thread; counters are only written by their owner
+        struct Watek {
+            unsigned id = 0;
+            std::atomic<std::uint64_t> counters[COUNTERS] = {};
+            std::mutex timers_mutex;
+            std::map<std::string, Czas, std::less<>> timers;
+        };
+
+        class Rejestr {
+        private:
+            std::mutex mutex_;
+            std::vector<std::shared_ptr<Watek>> threads_;
+
+        public:
+            static Rejestr& instance() {
+                static Rejestr registry;
+                return registry;
+            }
+
+            std::shared_ptr<Watek> add() {
+                auto thread = std::make_shared<Watek>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                thread->id = threads_.size();
+                threads_.push_back(thread);
+                return thread;
+            }
+
+            std::vector<std::shared_ptr<Watek>> threads() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return threads_;
+            }
+        };
+
+        inline Watek& current() {
+            thread_local std::shared_ptr<Watek> thread = Rejestr::instance().add();
+            return *thread;
+        }
+
+        inline void count(Licznik counter, std::uint64_t n) {
+            current().counters[static_cast<unsigned>(counter)].fetch_add(n, std::memory_order_relaxed);
+        }
+
+        // Adds the lifetime of the object to the named timer of the current thread
+        class ZegarZakresu {
+        private:
+            const char* name_;
+            std::chrono::steady_clock::time_point start_;
+
+        public:
+            explicit ZegarZakresu(const char* name)
+                : name_(name), start_(std::chrono::steady_clock::now()) {}
+
+            ZegarZakresu(const ZegarZakresu&) = delete;
+            ZegarZakresu& operator=(const ZegarZakresu&) = delete;
+
+            ~ZegarZakresu() {
+                auto elapsed = std::chrono::steady_clock::now() - start_;
+                Watek& thread = current();
+                std::lock_guard<std::mutex> lock(thread.timers_mutex);
+                auto it = thread.timers.find(name_);
+                if (it == thread.timers.end()) {
+                    it = thread.timers.emplace(name_, Czas()).first;
+                }
+                ++it->second.calls;
+                it->second.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            }
+        };
+
+        inline void reset() {
+            for (const auto& thread : Rejestr::instance().threads()) {
+                for (auto& counter : thread->counters) {
+                    counter.store(0, std::memory_order_relaxed);
+                }
+                std::lock_guard<std::mutex> lock(thread->timers_mutex);
+                thread->timers.clear();
+            }
+        }
+
+        // JSON report with per-thread and total counters and timers
+        inline void dump(std::ostream& out) {
+            auto writeCounters = [&out](const std::uint64_t* values) {
+                out << "{";
+                for (unsigned i = 0; i < COUNTERS; ++i) {
+                    out << (i == 0 ? "" : ", ") << '"' << name(static_cast<Licznik>(i)) << "\": " << values[i];
+                }
+                out << "}";
+            };
+            auto writeTimers = [&out](const std::map<std::string, Czas, std::less<>>& timers) {
+                out << "{";
+                bool first = true;
+                for (const auto& timer : timers) {
+                    out << (first ? "" : ", ") << '"' << timer.first << "\": {\"calls\": "
+                        << timer.second.calls << ", \"nanoseconds\": " << timer.second.nanoseconds << "}";
+                    first = false;
+                }
+                out << "}";
+            };
+
+            std::uint64_t total_counters[COUNTERS] = {};
+            std::map<std::string, Czas, std::less<>> total_timers;
+
+            out << "{\n  \"enabled\": true,\n  \"threads\": [";
+            bool first = true;
+            for (const auto& thread : Rejestr::instance().threads()) {
+                std::uint64_t counters[COUNTERS];
+                for (unsigned i = 0; i < COUNTERS; ++i) {
+                    counters[i] = thread->counters[i].load(std::memory_order_relaxed);
+                    total_counters[i] += counters[i];
+                }
+                std::map<std::string, Czas, std::less<>> timers;
+                {
+                    std::lock_guard<std::mutex> lock(thread->timers_mutex);
+                    timers = thread->timers;
+                }
+                for (const auto& timer : timers) {
+                    total_timers[timer.first].calls += timer.second.calls;
+                    total_timers[timer.first].nanoseconds += timer.second.nanoseconds;
+                }
+
+                out << (first ? "\n" : ",\n") << "    {\"thread\": " << thread->id << ", \"counters\": ";
+                writeCounters(counters);
+                out << ", \"timers\": ";
+                writeTimers(timers);
+                out << "}";
+                first = false;
+            }
+            out << "\n  ],\n  \"total\": {\"counters\": ";
+            writeCounters(total_counters);
+            out << ", \"timers\": ";
+            writeTimers(total_timers);
+            out << "}\n}\n";
+        }
+#else
+        inline void reset() {}
+
+        inline void dump(std::ostream& out) {
+            out << "{\n  \"enabled\": false\n}\n";
+        }
+#endif
+
+        inline std::string report() {
+            std::ostringstream out;
+            dump(out);
+            return out.str();
+        }
+    }
+}
+
+#endif //INSTRUMENTACJA_H
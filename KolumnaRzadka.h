@@ -0,0 +1,181 @@
+//Antoni Antoszek
+#ifndef KOLUMNARZADKA_H
+#define KOLUMNARZADKA_H
+#include "ZMod.h"
+#include "Instrumentacja.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace algebra {
+    // Sparse column of a boundary matrix over ZMod<p>.
+    // Rows are kept strictly increasing, so the pivot is always the last entry.
+    template<unsigned p>
+    class KolumnaRzadka {
+    private:
+        std::vector<std::size_t> rows_;
+        std::vector<ZMod<p>> values_;
+
+    public:
+        // Constructors
+        KolumnaRzadka() = default;
+
+        KolumnaRzadka(std::vector<std::size_t> rows, std::vector<ZMod<p>> values)
+            : rows_(std::move(rows)), values_(std::move(values)) {
+            if (rows_.size() != values_.size()) {
+                throw std::invalid_argument("Rows and values must have the same size");
+            }
+            for (std::size_t i = 1; i < rows_.size(); ++i) {
+                if (rows_[i - 1] >= rows_[i]) {
+                    throw std::invalid_argument("Rows must be strictly increasing");
+                }
+            }
+        }
+
+        KolumnaRzadka(const KolumnaRzadka& other) : rows_(other.rows_), values_(other.values_) {
+            ALGEBRA_COUNT_BUFFER(rows_);
+            ALGEBRA_COUNT_BUFFER(values_);
+        }
+
+        KolumnaRzadka(KolumnaRzadka&&) noexcept = default;
+
+        // Assignment operators
+        KolumnaRzadka& operator=(const KolumnaRzadka& other) {
+            if (this != &other) {
+                ALGEBRA_COUNT_ALLOCATION(rows_, other.rows_.size());
+                ALGEBRA_COUNT_ALLOCATION(values_, other.values_.size());
+                rows_ = other.rows_;
+                values_ = other.values_;
+            }
+            return *this;
+        }
+
+        KolumnaRzadka& operator=(KolumnaRzadka&&) noexcept = default;
+
+        // Getters
+        bool empty() const { return rows_.empty(); }
+        std::size_t size() const { return rows_.size(); }
+
+        const std::vector<std::size_t>& getRows() const { return rows_; }
+        const std::vector<ZMod<p>>& getValues() const { return values_; }
+
+        std::size_t pivot() const {
+            if (rows_.empty()) {
+                throw std::out_of_range("Empty column has no pivot");
+            }
+            return rows_.back();
+        }
+
+        const ZMod<p>& pivotValue() const {
+            if (values_.empty()) {
+                throw std::out_of_range("Empty column has no pivot");
+            }
+            return values_.back();
+        }
+
+        ZMod<p> get(std::size_t row) const {
+            auto it = std::lower_bound(rows_.begin(), rows_.end(), row);
+            if (it != rows_.end() && *it == row) {
+                return values_[std::distance(rows_.begin(), it)];
+            }
+            return ZMod<p>(0);
+        }
+
+        // Heap bytes held by the column
+        std::size_t getMemoryUsage() const {
+            return rows_.capacity() * sizeof(std::size_t) + values_.capacity() * sizeof(ZMod<p>);
+        }
+
+        // Setters
+        void append(std::size_t row, const ZMod<p>& value) {
+            if (!rows_.empty() && rows_.back() >= row) {
+                throw std::invalid_argument("Rows must be strictly increasing");
+            }
+            if (value != ZMod<p>(0)) {
+                ALGEBRA_COUNT_ALLOCATION(rows_, rows_.size() + 1);
+                ALGEBRA_COUNT_ALLOCATION(values_, values_.size() + 1);
+                rows_.push_back(row);
+                values_.push_back(value);
+            }
+        }
+
+        void clear() {
+            rows_.clear();
+            values_.clear();
+        }
+
+        // Reallocates to the exact size unless the column is already tight or empty
+        void shrink() {
+            ALGEBRA_COUNT(Allocations, !rows_.empty() && rows_.capacity() > rows_.size() ? 1 : 0);
+            ALGEBRA_COUNT(Allocations, !values_.empty() && values_.capacity() > values_.size() ? 1 : 0);
+            rows_.shrink_to_fit();
+            values_.shrink_to_fit();
+        }
+
+        // this += factor * other, merging the two sorted row lists
+        void addMultiple(const KolumnaRzadka& other, const ZMod<p>& factor) {
+            if (factor == ZMod<p>(0) || other.empty()) {
+                return;
+            }
+            std::vector<std::size_t> rows;
+            std::vector<ZMod<p>> values;
+            ALGEBRA_COUNT_ALLOCATION(rows, rows_.size() + other.rows_.size());
+            ALGEBRA_COUNT_ALLOCATION(values, rows_.size() + other.rows_.size());
+            rows.reserve(rows_.size() + other.rows_.size());
+            values.reserve(rows_.size() + other.rows_.size());
+
+            std::size_t i = 0, j = 0;
+            while (i < rows_.size() || j < other.rows_.size()) {
+                if (j == other.rows_.size() || (i < rows_.size() && rows_[i] < other.rows_[j])) {
+                    rows.push_back(rows_[i]);
+                    values.push_back(values_[i]);
+                    ++i;
+                } else if (i == rows_.size() || other.rows_[j] < rows_[i]) {
+                    rows.push_back(other.rows_[j]);
+                    values.push_back(factor * other.values_[j]);
+                    ++j;
+                } else {
+                    ZMod<p> sum = values_[i] + factor * other.values_[j];
+                    if (sum != ZMod<p>(0)) {
+                        rows.push_back(rows_[i]);
+                        values.push_back(sum);
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            rows_.swap(rows);
+            values_.swap(values);
+        }
+
+        // Factor f such that this + f * other has no entry at the pivot of other
+        ZMod<p> eliminationFactor(const KolumnaRzadka& other) const {
+            return -(get(other.pivot()) * other.pivotValue().inverse());
+        }
+
+        // Comparison operators
+        bool operator==(const KolumnaRzadka& other) const {
+            return rows_ == other.rows_ && values_ == other.values_;
+        }
+
+        bool operator!=(const KolumnaRzadka& other) const {
+            return !(*this == other);
+        }
+
+        // Stream operator
+        friend std::ostream& operator<<(std::ostream& out, const KolumnaRzadka& column) {
+            out << "[";
+            for (std::size_t i = 0; i < column.rows_.size(); ++i) {
+                if (i != 0) {
+                    out << ',';
+                }
+                out << '(' << column.values_[i] << ',' << column.rows_[i] << ')';
+            }
+            out << "]";
+            return out;
+        }
+    };
+}
+
+#endif //KOLUMNARZADKA_H
@@ -18,9 +18,11 @@ namespace algebra {
 
         explicit Kompleks(const Sympleks<S, d>& simplex) : BaseType(simplex) {}
 
-        Kompleks(const Sympleks<S,d>& x) {
-            this->generators.push_back(x);
-            this->coefficients.push_back(ZMod<p>(1));}
+        Kompleks(const Kompleks& other) : BaseType(other) {}
+
+        Kompleks(const std::vector<Sympleks<S, d>>& generators,
+                const std::vector<ZMod<p>>& coefficients)
+            : BaseType(generators, coefficients) {}
 
         // Getters
         unsigned getDimension() const { return d; }
@@ -50,6 +52,7 @@ namespace algebra {
 
     private:
         Kompleks<S, d-1, p> computeBoundary() const {
+            ALGEBRA_SCOPED_TIMER("Kompleks::boundary");
             Kompleks<S, d-1, p> result;
 
             // Special case: boundary of 1-simplex is always empty
@@ -60,24 +63,26 @@ namespace algebra {
             const auto& generators = this->getGenerators();
             const auto& coefficients = this->getCoefficients();
 
+            // Faces are built here rather than through Sympleks::boundary(), whose
+            // ZMod<d> coefficients cannot tell -1 from +1 when d == 2
+            std::vector<S> face(d - 1);
+            ALGEBRA_COUNT_BUFFER(face);
             for (size_t i = 0; i < generators.size(); ++i) {
-                const Sympleks<S, d>& simplex = generators[i];
+                const std::vector<S>& sequence = generators[i].getSequence();
                 const ZMod<p>& simplex_coeff = coefficients[i];
 
-                WolnyModul<Sympleks<S, d-1>, d> boundary_module = simplex.boundary();
-
-                for (auto it = boundary_module.begin(); it != boundary_module.end(); ++it) {
-                    const Sympleks<S, d-1>& boundary_simplex = it->generator();
-                    int coeff_val = static_cast<int>(it->wspolczynnik());
-
-                    // Adjust for negatives if d > 1
-                    if (d > 1 && coeff_val > static_cast<int>(d)/2) {
-                        coeff_val -= d;
+                std::copy(sequence.begin() + 1, sequence.end(), face.begin());
+                for (unsigned j = 0; j < d; ++j) {
+                    if (j > 0) {
+                        face[j - 1] = sequence[j - 1];
                     }
-
-                    result.addGenerator(boundary_simplex, ZMod<p>(coeff_val) * simplex_coeff);
+                    Sympleks<S, d-1> boundary_simplex;
+                    boundary_simplex.setSequence(face);
+                    ZMod<p> sign = (j % 2 == 0) ? ZMod<p>(1) : -ZMod<p>(1);
+                    result.addGenerator(boundary_simplex, sign * simplex_coeff);
                 }
             }
+            ALGEBRA_COUNT(BoundaryFaces, generators.size() * d);
 
             return result;
         }
@@ -102,6 +107,8 @@ namespace algebra {
 
             std::vector<Sympleks<S, d>> neg_generators = generators;
             std::vector<ZMod<p>> neg_coefficients;
+            ALGEBRA_COUNT_BUFFER(neg_generators);
+            ALGEBRA_COUNT_ALLOCATION(neg_coefficients, coefficients.size());
             neg_coefficients.reserve(coefficients.size());
 
             for (const auto& coeff : coefficients) {
@@ -119,6 +126,8 @@ namespace algebra {
 
             std::vector<Sympleks<S, d>> scalar_generators = generators;
             std::vector<ZMod<p>> scalar_coefficients;
+            ALGEBRA_COUNT_BUFFER(scalar_generators);
+            ALGEBRA_COUNT_ALLOCATION(scalar_coefficients, coefficients.size());
             scalar_coefficients.reserve(coefficients.size());
 
             for (const auto& coeff : coefficients) {
@@ -149,7 +158,7 @@ namespace algebra {
             : BaseType(generators, coefficients) {}
 
         // Destructor
-        ~Kompleks() override = default;
+        ~Kompleks() = default;
 
         // Getters
         unsigned getDimension() const { return 0; }
@@ -196,6 +205,8 @@ namespace algebra {
 
             std::vector<Sympleks<S, 0>> neg_generators = generators;
             std::vector<ZMod<p>> neg_coefficients;
+            ALGEBRA_COUNT_BUFFER(neg_generators);
+            ALGEBRA_COUNT_ALLOCATION(neg_coefficients, coefficients.size());
             neg_coefficients.reserve(coefficients.size());
 
             for (const auto& coeff : coefficients) {
@@ -213,6 +224,8 @@ namespace algebra {
 
             std::vector<Sympleks<S, 0>> scalar_generators = generators;
             std::vector<ZMod<p>> scalar_coefficients;
+            ALGEBRA_COUNT_BUFFER(scalar_generators);
+            ALGEBRA_COUNT_ALLOCATION(scalar_coefficients, coefficients.size());
             scalar_coefficients.reserve(coefficients.size());
 
             for (const auto& coeff : coefficients) {
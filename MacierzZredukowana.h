@@ -0,0 +1,92 @@
+//Antoni Antoszek
+#ifndef MACIERZZREDUKOWANA_H
+#define MACIERZZREDUKOWANA_H
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "KolumnaRzadka.h"
+
+namespace algebra {
+    // Boundary matrix reduced column by column (standard persistence algorithm).
+    // Column j is appended only after columns 0..j-1, so rows always refer to earlier columns.
+    template<unsigned p>
+    class MacierzZredukowana {
+    public:
+        static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    private:
+        std::vector<KolumnaRzadka<p>> columns_;
+        std::vector<std::size_t> pivot_owners_;
+
+    public:
+        // Constructors
+        MacierzZredukowana() = default;
+
+        // Getters
+        std::size_t size() const { return columns_.size(); }
+
+        const KolumnaRzadka<p>& getColumn(std::size_t index) const {
+            if (index >= columns_.size()) {
+                throw std::out_of_range("Column index out of bounds");
+            }
+            return columns_[index];
+        }
+
+        // Column whose pivot lies in the given row, or NONE
+        std::size_t getPivotOwner(std::size_t row) const {
+            return row < pivot_owners_.size() ? pivot_owners_[row] : NONE;
+        }
+
+        std::size_t getMemoryUsage() const {
+            std::size_t bytes = columns_.capacity() * sizeof(KolumnaRzadka<p>)
+                + pivot_owners_.capacity() * sizeof(std::size_t);
+            for (const auto& column : columns_) {
+                bytes += column.getMemoryUsage();
+            }
+            return bytes;
+        }
+
+        // Setters
+        // Reduces the column against the stored ones and appends it. Every column
+        // operation column += factor * getColumn(owner) is reported to onAdd(owner, factor).
+        template<class F>
+        std::size_t addColumn(KolumnaRzadka<p> column, F&& onAdd) {
+            if (!column.empty() && column.pivot() >= columns_.size()) {
+                throw std::invalid_argument("Column refers to a later row");
+            }
+            while (!column.empty()) {
+                std::size_t owner = pivot_owners_[column.pivot()];
+                if (owner == NONE) {
+                    break;
+                }
+                ZMod<p> factor = column.eliminationFactor(columns_[owner]);
+                column.addMultiple(columns_[owner], factor);
+                ALGEBRA_COUNT(ColumnAdditions, 1);
+                onAdd(owner, factor);
+            }
+
+            std::size_t index = columns_.size();
+            ALGEBRA_COUNT_ALLOCATION(pivot_owners_, pivot_owners_.size() + 1);
+            pivot_owners_.push_back(NONE);
+            if (!column.empty()) {
+                pivot_owners_[column.pivot()] = index;
+            }
+            column.shrink();
+            ALGEBRA_COUNT_ALLOCATION(columns_, columns_.size() + 1);
+            columns_.push_back(std::move(column));
+            return index;
+        }
+
+        std::size_t addColumn(KolumnaRzadka<p> column) {
+            return addColumn(std::move(column), [](std::size_t, const ZMod<p>&) {});
+        }
+
+        void clear() {
+            columns_.clear();
+            pivot_owners_.clear();
+        }
+    };
+}
+
+#endif //MACIERZZREDUKOWANA_H
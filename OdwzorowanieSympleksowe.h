@@ -0,0 +1,177 @@
+//Antoni Antoszek
+#ifndef ODWZOROWANIESYMPLEKSOWE_H
+#define ODWZOROWANIESYMPLEKSOWE_H
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Homologia.h"
+
+namespace algebra {
+    // Simplicial map given by a map of vertices S -> T. Chains are pushed forward in
+    // batch: simplices with repeated image vertices are dropped and the rest are
+    // written in sorted vertex order with the sign of the sorting permutation.
+    template<class S, class T>
+    class OdwzorowanieSympleksowe {
+    private:
+        std::map<S, T> vertices_;
+
+        const T& image(const S& vertex) const {
+            auto it = vertices_.find(vertex);
+            if (it == vertices_.end()) {
+                throw std::out_of_range("Vertex is not in the domain of the map");
+            }
+            return it->second;
+        }
+
+        // Maps and sorts the simplex; returns the permutation sign, or 0 if degenerate
+        int mapSimplex(const std::vector<S>& simplex, std::vector<T>& result) const {
+            result.clear();
+            for (const S& vertex : simplex) {
+                result.push_back(image(vertex));
+            }
+            int sign = 1;
+            for (std::size_t i = 1; i < result.size(); ++i) {
+                for (std::size_t j = i; j > 0 && result[j] < result[j - 1]; --j) {
+                    std::swap(result[j], result[j - 1]);
+                    sign = -sign;
+                }
+            }
+            if (std::adjacent_find(result.begin(), result.end()) != result.end()) {
+                return 0;
+            }
+            return sign;
+        }
+
+    public:
+        // Constructors
+        OdwzorowanieSympleksowe() = default;
+
+        explicit OdwzorowanieSympleksowe(std::map<S, T> vertices) : vertices_(std::move(vertices)) {}
+
+        // Getters
+        const std::map<S, T>& getVertexMap() const { return vertices_; }
+
+        const T& operator()(const S& vertex) const { return image(vertex); }
+
+        // Setters
+        void setImage(const S& vertex, const T& target) {
+            vertices_[vertex] = target;
+        }
+
+        // Image of a chain; the result is normalized once, on first access
+        template<unsigned d, unsigned p>
+        Kompleks<T, d, p> pushForward(const Kompleks<S, d, p>& chain) const {
+            const auto& generators = chain.getGenerators();
+            const auto& coefficients = chain.getCoefficients();
+
+            std::vector<Sympleks<T, d>> images;
+            std::vector<ZMod<p>> image_coefficients;
+            images.reserve(generators.size());
+            image_coefficients.reserve(generators.size());
+
+            std::vector<T> simplex;
+            for (std::size_t i = 0; i < generators.size(); ++i) {
+                int sign = mapSimplex(generators[i].getSequence(), simplex);
+                if (sign == 0) {
+                    continue;
+                }
+                images.push_back(Sympleks<T, d>(simplex.data()));
+                image_coefficients.push_back(sign > 0 ? coefficients[i] : -coefficients[i]);
+            }
+            return Kompleks<T, d, p>(images, image_coefficients);
+        }
+
+        // Image of a column over simplices of `source` as a column over simplices of `target`
+        template<unsigned p>
+        KolumnaRzadka<p> pushForward(const Filtracja<S>& source, const Filtracja<T>& target,
+                                     const KolumnaRzadka<p>& column) const {
+            std::vector<std::pair<std::size_t, ZMod<p>>> entries;
+            entries.reserve(column.size());
+
+            std::vector<T> simplex;
+            for (std::size_t i = 0; i < column.size(); ++i) {
+                int sign = mapSimplex(source.getSimplex(column.getRows()[i]), simplex);
+                if (sign == 0) {
+                    continue;
+                }
+                const ZMod<p>& value = column.getValues()[i];
+                entries.emplace_back(target.indexOf(simplex), sign > 0 ? value : -value);
+            }
+            std::sort(entries.begin(), entries.end(),
+                [](const std::pair<std::size_t, ZMod<p>>& a, const std::pair<std::size_t, ZMod<p>>& b) {
+                    return a.first < b.first;
+                });
+
+            KolumnaRzadka<p> result;
+            for (std::size_t i = 0; i < entries.size();) {
+                std::size_t row = entries[i].first;
+                ZMod<p> sum;
+                for (; i < entries.size() && entries[i].first == row; ++i) {
+                    sum = sum + entries[i].second;
+                }
+                result.append(row, sum);
+            }
+            return result;
+        }
+
+        // Matrix of the induced map H_dimension(source) -> H_dimension(target) in the
+        // bases of getRepresentativeCycles(): entry [i][j] is the coefficient of the
+        // i-th target class in the image of the j-th source class. Both homologies
+        // must track representatives in this dimension.
+        template<unsigned p>
+        std::vector<std::vector<ZMod<p>>> inducedMap(const Homologia<S, p>& source,
+                                                     const Homologia<T, p>& target,
+                                                     unsigned dimension) const {
+            using Przedzial = typename Homologia<S, p>::Przedzial;
+            const std::size_t NONE = MacierzZredukowana<p>::NONE;
+
+            std::vector<std::size_t> source_basis;
+            for (const Przedzial& bar : source.getPersistencePairs()) {
+                if (bar.death == NONE && bar.dimension == dimension) {
+                    source_basis.push_back(bar.birth);
+                }
+            }
+            std::map<std::size_t, std::size_t> target_basis;
+            for (const auto& bar : target.getPersistencePairs()) {
+                if (bar.death == NONE && bar.dimension == dimension) {
+                    target_basis.emplace(bar.birth, target_basis.size());
+                }
+            }
+
+            const MacierzZredukowana<p>& boundaries = target.getReducedMatrix();
+            std::vector<std::vector<ZMod<p>>> matrix(target_basis.size(),
+                std::vector<ZMod<p>>(source_basis.size()));
+
+            for (std::size_t j = 0; j < source_basis.size(); ++j) {
+                KolumnaRzadka<p> cycle = pushForward(source.getFiltration(), target.getFiltration(),
+                    source.getRepresentative(source_basis[j]));
+
+                // Lowest entries of boundaries and of surviving cycles are all distinct,
+                // so eliminating from the bottom yields the coordinates of the class
+                while (!cycle.empty()) {
+                    std::size_t row = cycle.pivot();
+                    std::size_t owner = boundaries.getPivotOwner(row);
+                    if (owner != NONE) {
+                        const KolumnaRzadka<p>& boundary = boundaries.getColumn(owner);
+                        cycle.addMultiple(boundary, cycle.eliminationFactor(boundary));
+                        continue;
+                    }
+                    auto basis = target_basis.find(row);
+                    if (basis == target_basis.end()) {
+                        throw std::logic_error("Image of a cycle is not a cycle");
+                    }
+                    KolumnaRzadka<p> representative = target.getRepresentative(row);
+                    ZMod<p> coordinate = cycle.pivotValue() * representative.pivotValue().inverse();
+                    matrix[basis->second][j] = coordinate;
+                    cycle.addMultiple(representative, -coordinate);
+                }
+            }
+            return matrix;
+        }
+    };
+}
+
+#endif //ODWZOROWANIESYMPLEKSOWE_H
@@ -11,6 +11,8 @@ namespace algebra {
     template<class S, unsigned d>
     class Sympleks {
     private:
+        template<class, unsigned> friend class Sympleks;
+
         std::vector<S> sequence_;
 
         void validateIndex(unsigned index) const {
@@ -22,15 +24,19 @@ namespace algebra {
     public:
         // Constructors
         Sympleks() {
+            ALGEBRA_COUNT_ALLOCATION(sequence_, d);
             sequence_.reserve(d);
             for (unsigned i = 0; i < d; ++i) {
                 sequence_.push_back(S());
             }
         }
 
-        Sympleks(const Sympleks& other) : sequence_(other.sequence_) {}
+        Sympleks(const Sympleks& other) : sequence_(other.sequence_) {
+            ALGEBRA_COUNT_BUFFER(sequence_);
+        }
 
         explicit Sympleks(const S sequence[]) {
+            ALGEBRA_COUNT_ALLOCATION(sequence_, d);
             sequence_.reserve(d);
             for (unsigned i = 0; i < d; ++i) {
                 sequence_.push_back(sequence[i]);
@@ -55,12 +61,14 @@ namespace algebra {
             if (new_sequence.size() != d) {
                 throw std::invalid_argument("Sequence size must match dimension");
             }
+            ALGEBRA_COUNT_ALLOCATION(sequence_, new_sequence.size());
             sequence_ = new_sequence;
         }
 
         // Assignment operator
         Sympleks& operator=(const Sympleks& other) {
             if (this != &other) {
+                ALGEBRA_COUNT_ALLOCATION(sequence_, other.sequence_.size());
                 sequence_ = other.sequence_;
             }
             return *this;
@@ -105,8 +113,13 @@ namespace algebra {
                 return WolnyModul<Sympleks<S, d-1>, d>();
             }
 
+            ALGEBRA_COUNT(BoundaryFaces, d);
             std::vector<Sympleks<S, d-1>> generators;
             std::vector<ZMod<d>> coefficients;
+            ALGEBRA_COUNT_ALLOCATION(generators, d);
+            ALGEBRA_COUNT_ALLOCATION(coefficients, d);
+            generators.reserve(d);
+            coefficients.reserve(d);
 
             for (unsigned i = 0; i < d; ++i) {
                 Sympleks<S, d-1> boundary_simplex;
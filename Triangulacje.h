@@ -0,0 +1,337 @@
+//Antoni Antoszek
+#ifndef TRIANGULACJE_H
+#define TRIANGULACJE_H
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "Kompleks.h"
+
+namespace algebra {
+    // Vertex of a barycentric subdivision: the barycenter of a face, given by its sorted vertices
+    template<class S>
+    class Barycentrum {
+    private:
+        std::vector<S> face_;
+
+    public:
+        // Constructors
+        Barycentrum() = default;
+
+        explicit Barycentrum(std::vector<S> face) : face_(std::move(face)) {
+            std::sort(face_.begin(), face_.end());
+        }
+
+        // Getters
+        const std::vector<S>& getFace() const { return face_; }
+
+        // Comparison operators
+        bool operator<(const Barycentrum& other) const { return face_ < other.face_; }
+        bool operator<=(const Barycentrum& other) const { return face_ <= other.face_; }
+        bool operator==(const Barycentrum& other) const { return face_ == other.face_; }
+        bool operator!=(const Barycentrum& other) const { return face_ != other.face_; }
+
+        // Stream operator
+        friend std::ostream& operator<<(std::ostream& out, const Barycentrum& vertex) {
+            out << "b{";
+            for (std::size_t i = 0; i < vertex.face_.size(); ++i) {
+                out << (i == 0 ? "" : ",") << vertex.face_[i];
+            }
+            out << '}';
+            return out;
+        }
+    };
+
+    // Vertex of a product complex
+    template<class S, class T>
+    class Para {
+    private:
+        S first_;
+        T second_;
+
+    public:
+        // Constructors
+        Para() : first_(), second_() {}
+        Para(const S& first, const T& second) : first_(first), second_(second) {}
+
+        // Getters
+        const S& getFirst() const { return first_; }
+        const T& getSecond() const { return second_; }
+
+        // Comparison operators
+        bool operator<(const Para& other) const {
+            return first_ < other.first_ || (first_ == other.first_ && second_ < other.second_);
+        }
+        bool operator<=(const Para& other) const { return *this < other || *this == other; }
+        bool operator==(const Para& other) const { return first_ == other.first_ && second_ == other.second_; }
+        bool operator!=(const Para& other) const { return !(*this == other); }
+
+        // Stream operator
+        friend std::ostream& operator<<(std::ostream& out, const Para& vertex) {
+            out << '<' << vertex.first_ << ',' << vertex.second_ << '>';
+            return out;
+        }
+    };
+
+    // Oriented simplex produced by a generator, with its sign in the image chain
+    template<class V, unsigned n>
+    class Wpis {
+    private:
+        Sympleks<V, n> simplex_;
+        int sign_ = 1;
+
+    public:
+        Sympleks<V, n>& simplex() { return simplex_; }
+        void setSign(int sign) { sign_ = sign; }
+
+        const Sympleks<V, n>& generator() const { return simplex_; }
+        int wspolczynnik() const { return sign_; }
+    };
+
+    // Barycentric subdivision of one simplex, generated lazily. Each of the d!
+    // simplices is the flag sigma > sigma - {v_pi(0)} > ... > {v_pi(d-1)} for a
+    // permutation pi of the vertices, with sign(pi) as its coefficient, so that
+    // subdivision commutes with the boundary.
+    template<class S, unsigned d>
+    class PodzialBarycentryczny {
+        static_assert(d > 0, "Only simplices with at least one vertex can be subdivided");
+
+    private:
+        std::vector<S> vertices_;
+
+    public:
+        using Element = Wpis<Barycentrum<S>, d>;
+
+        class const_iterator {
+        private:
+            const std::vector<S>* vertices_;
+            std::vector<unsigned> permutation_;
+            bool done_;
+            Element current_;
+
+            void build() {
+                int sign = 1;
+                for (unsigned i = 0; i < d; ++i) {
+                    for (unsigned j = i + 1; j < d; ++j) {
+                        if (permutation_[i] > permutation_[j]) {
+                            sign = -sign;
+                        }
+                    }
+                }
+                std::vector<S> face;
+                for (unsigned k = 0; k < d; ++k) {
+                    face.clear();
+                    for (unsigned i = k; i < d; ++i) {
+                        face.push_back((*vertices_)[permutation_[i]]);
+                    }
+                    current_.simplex()[k + 1] = Barycentrum<S>(face);
+                }
+                current_.setSign(sign);
+            }
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Element;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Element*;
+            using reference = const Element&;
+
+            const_iterator(const std::vector<S>* vertices, bool done)
+                : vertices_(vertices), permutation_(d), done_(done) {
+                for (unsigned i = 0; i < d; ++i) {
+                    permutation_[i] = i;
+                }
+                if (!done_) {
+                    build();
+                }
+            }
+
+            const Element& operator*() const { return current_; }
+            const Element* operator->() const { return &current_; }
+
+            const_iterator& operator++() {
+                done_ = !std::next_permutation(permutation_.begin(), permutation_.end());
+                if (!done_) {
+                    build();
+                }
+                return *this;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return done_ == other.done_ && (done_ || permutation_ == other.permutation_);
+            }
+
+            bool operator!=(const const_iterator& other) const {
+                return !(*this == other);
+            }
+        };
+
+        // Constructors
+        explicit PodzialBarycentryczny(const Sympleks<S, d>& simplex) : vertices_(simplex.getSequence()) {}
+
+        // Getters
+        std::size_t size() const {
+            std::size_t count = 1;
+            for (unsigned i = 2; i <= d; ++i) {
+                count *= i;
+            }
+            return count;
+        }
+
+        const_iterator begin() const { return const_iterator(&vertices_, false); }
+        const_iterator end() const { return const_iterator(&vertices_, true); }
+    };
+
+    // Eilenberg-Zilber triangulation of the product of an m-vertex and an n-vertex
+    // simplex, generated lazily. Each simplex is a monotone lattice path from
+    // (a_1, b_1) to (a_m, b_n), with the sign of the corresponding shuffle.
+    template<class S, class T, unsigned m, unsigned n>
+    class IloczynSympleksowy {
+        static_assert(m > 0 && n > 0, "Factors must have at least one vertex");
+
+    private:
+        std::vector<S> first_;
+        std::vector<T> second_;
+
+    public:
+        using Element = Wpis<Para<S, T>, m + n - 1>;
+
+        class const_iterator {
+        private:
+            const std::vector<S>* first_;
+            const std::vector<T>* second_;
+            std::vector<unsigned char> steps_;
+            bool done_;
+            Element current_;
+
+            void build() {
+                int sign = 1;
+                unsigned second_steps = 0;
+                unsigned i = 0, j = 0;
+                current_.simplex()[1] = Para<S, T>((*first_)[0], (*second_)[0]);
+                for (std::size_t k = 0; k < steps_.size(); ++k) {
+                    if (steps_[k] == 0) {
+                        ++i;
+                        if (second_steps % 2 == 1) {
+                            sign = -sign;
+                        }
+                    } else {
+                        ++j;
+                        ++second_steps;
+                    }
+                    current_.simplex()[k + 2] = Para<S, T>((*first_)[i], (*second_)[j]);
+                }
+                current_.setSign(sign);
+            }
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Element;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Element*;
+            using reference = const Element&;
+
+            const_iterator(const std::vector<S>* first, const std::vector<T>* second, bool done)
+                : first_(first), second_(second), steps_(m + n - 2, 0), done_(done) {
+                std::fill(steps_.begin() + (m - 1), steps_.end(), 1);
+                if (!done_) {
+                    build();
+                }
+            }
+
+            const Element& operator*() const { return current_; }
+            const Element* operator->() const { return &current_; }
+
+            const_iterator& operator++() {
+                done_ = !std::next_permutation(steps_.begin(), steps_.end());
+                if (!done_) {
+                    build();
+                }
+                return *this;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return done_ == other.done_ && (done_ || steps_ == other.steps_);
+            }
+
+            bool operator!=(const const_iterator& other) const {
+                return !(*this == other);
+            }
+        };
+
+        // Constructors
+        IloczynSympleksowy(const Sympleks<S, m>& first, const Sympleks<T, n>& second)
+            : first_(first.getSequence()), second_(second.getSequence()) {}
+
+        // Getters
+        std::size_t size() const {
+            std::size_t count = 1;
+            for (unsigned k = 1; k < n; ++k) {
+                count = count * (m - 1 + k) / k;
+            }
+            return count;
+        }
+
+        const_iterator begin() const { return const_iterator(&first_, &second_, false); }
+        const_iterator end() const { return const_iterator(&first_, &second_, true); }
+    };
+
+    // Streams the subdivision of a chain to sink(simplex, coefficient) one simplex at
+    // a time; e.g. a sink calling addClosure(simplex.getSequence()) on a Filtracja or
+    // HomologiaPrzyrostowa feeds the reduction without building the subdivided chain.
+    template<class S, unsigned d, unsigned p, class F>
+    void barycentricSubdivision(const Kompleks<S, d, p>& chain, F&& sink) {
+        const auto& generators = chain.getGenerators();
+        const auto& coefficients = chain.getCoefficients();
+        for (std::size_t i = 0; i < generators.size(); ++i) {
+            PodzialBarycentryczny<S, d> subdivision(generators[i]);
+            for (const auto& element : subdivision) {
+                ZMod<p> sign(element.wspolczynnik());
+                sink(element.generator(), sign * coefficients[i]);
+            }
+        }
+    }
+
+    template<class S, unsigned d, unsigned p>
+    Kompleks<Barycentrum<S>, d, p> barycentricSubdivision(const Kompleks<S, d, p>& chain) {
+        Kompleks<Barycentrum<S>, d, p> result;
+        barycentricSubdivision(chain, [&result](const Sympleks<Barycentrum<S>, d>& simplex,
+                                                const ZMod<p>& coefficient) {
+            result.addGenerator(simplex, coefficient);
+        });
+        return result;
+    }
+
+    // Streams the Eilenberg-Zilber product of two chains to sink(simplex, coefficient)
+    template<class S, class T, unsigned m, unsigned n, unsigned p, class F>
+    void simplicialProduct(const Kompleks<S, m, p>& first, const Kompleks<T, n, p>& second, F&& sink) {
+        const auto& first_generators = first.getGenerators();
+        const auto& first_coefficients = first.getCoefficients();
+        const auto& second_generators = second.getGenerators();
+        const auto& second_coefficients = second.getCoefficients();
+        for (std::size_t i = 0; i < first_generators.size(); ++i) {
+            for (std::size_t j = 0; j < second_generators.size(); ++j) {
+                ZMod<p> coefficient = first_coefficients[i] * second_coefficients[j];
+                IloczynSympleksowy<S, T, m, n> product(first_generators[i], second_generators[j]);
+                for (const auto& element : product) {
+                    ZMod<p> sign(element.wspolczynnik());
+                    sink(element.generator(), sign * coefficient);
+                }
+            }
+        }
+    }
+
+    template<class S, class T, unsigned m, unsigned n, unsigned p>
+    Kompleks<Para<S, T>, m + n - 1, p> simplicialProduct(const Kompleks<S, m, p>& first,
+                                                          const Kompleks<T, n, p>& second) {
+        Kompleks<Para<S, T>, m + n - 1, p> result;
+        simplicialProduct(first, second, [&result](const Sympleks<Para<S, T>, m + n - 1>& simplex,
+                                                   const ZMod<p>& coefficient) {
+            result.addGenerator(simplex, coefficient);
+        });
+        return result;
+    }
+}
+
+#endif //TRIANGULACJE_H
@@ -2,6 +2,7 @@
 #ifndef WOLNYMODUL_H
 #define WOLNYMODUL_H
 #include "ZMod.h"
+#include "Instrumentacja.h"
 #include <algorithm>
 #include <vector>
 
@@ -14,10 +15,15 @@ namespace algebra {
         mutable bool is_normalized_;
 
         void normalize() const {
+            ALGEBRA_COUNT(NormalizeCalls, 1);
             if (is_normalized_) return;
             is_normalized_ = true;
+            ALGEBRA_SCOPED_TIMER("WolnyModul::normalize");
+            ALGEBRA_COUNT(NormalizeSorts, 1);
+            ALGEBRA_COUNT(SortedElements, generators_.size());
 
             std::vector<std::pair<S, ZMod<p>>> pairs;
+            ALGEBRA_COUNT_ALLOCATION(pairs, generators_.size());
             pairs.reserve(generators_.size());
             for (size_t i = 0; i < generators_.size(); ++i) {
                 pairs.emplace_back(generators_[i], coefficients_[i]);
@@ -36,6 +42,7 @@ namespace algebra {
                 ZMod<p> current_coeff = pairs[0].second;
                 for (size_t i = 1; i < pairs.size(); ++i) {
                     if (pairs[i].first == current_gen) {
+                        ALGEBRA_COUNT(Merges, 1);
                         current_coeff = current_coeff + pairs[i].second;
                     } else {
                         if (current_coeff != ZMod<p>(0)) {
@@ -58,16 +65,24 @@ namespace algebra {
         WolnyModul() : is_normalized_(true) {}
 
         explicit WolnyModul(const S& generator) : is_normalized_(false) {
+            ALGEBRA_COUNT_ALLOCATION(generators_, 1);
+            ALGEBRA_COUNT_ALLOCATION(coefficients_, 1);
             generators_.push_back(generator);
             coefficients_.push_back(ZMod<p>(1));
         }
 
         WolnyModul(const WolnyModul& other)
             : generators_(other.generators_), coefficients_(other.coefficients_),
-              is_normalized_(other.is_normalized_) {}
+              is_normalized_(other.is_normalized_) {
+            ALGEBRA_COUNT_BUFFER(generators_);
+            ALGEBRA_COUNT_BUFFER(coefficients_);
+        }
 
         WolnyModul(const std::vector<S>& generators, const std::vector<ZMod<p>>& coefficients)
-            : generators_(generators), coefficients_(coefficients), is_normalized_(false) {}
+            : generators_(generators), coefficients_(coefficients), is_normalized_(false) {
+            ALGEBRA_COUNT_BUFFER(generators_);
+            ALGEBRA_COUNT_BUFFER(coefficients_);
+        }
 
         // Getters
         const std::vector<S>& getGenerators() const {
@@ -106,6 +121,8 @@ namespace algebra {
                 size_t index = std::distance(generators_.begin(), it);
                 coefficients_[index] = ZMod<p>(coefficient);
             } else {
+                ALGEBRA_COUNT_ALLOCATION(generators_, generators_.size() + 1);
+                ALGEBRA_COUNT_ALLOCATION(coefficients_, coefficients_.size() + 1);
                 generators_.push_back(generator);
                 coefficients_.push_back(ZMod<p>(coefficient));
             }
@@ -113,6 +130,8 @@ namespace algebra {
         }
 
         void addGenerator(const S& generator, const ZMod<p>& coefficient = ZMod<p>(1)) {
+            ALGEBRA_COUNT_ALLOCATION(generators_, generators_.size() + 1);
+            ALGEBRA_COUNT_ALLOCATION(coefficients_, coefficients_.size() + 1);
             generators_.push_back(generator);
             coefficients_.push_back(coefficient);
             is_normalized_ = false;
@@ -127,6 +146,8 @@ namespace algebra {
         // Assignment operators
         WolnyModul& operator=(const WolnyModul& other) {
             if (this != &other) {
+                ALGEBRA_COUNT_ALLOCATION(generators_, other.generators_.size());
+                ALGEBRA_COUNT_ALLOCATION(coefficients_, other.coefficients_.size());
                 generators_ = other.generators_;
                 coefficients_ = other.coefficients_;
                 is_normalized_ = other.is_normalized_;
@@ -136,6 +157,8 @@ namespace algebra {
 
         WolnyModul& operator=(const S& generator) {
             clear();
+            ALGEBRA_COUNT_ALLOCATION(generators_, 1);
+            ALGEBRA_COUNT_ALLOCATION(coefficients_, 1);
             generators_.push_back(generator);
             coefficients_.push_back(ZMod<p>(1));
             is_normalized_ = false;
@@ -144,6 +167,8 @@ namespace algebra {
 
         // Compound assignment operators
         WolnyModul& operator+=(const WolnyModul& other) {
+            ALGEBRA_COUNT_ALLOCATION(generators_, generators_.size() + other.generators_.size());
+            ALGEBRA_COUNT_ALLOCATION(coefficients_, coefficients_.size() + other.coefficients_.size());
             generators_.insert(generators_.end(), other.generators_.begin(), other.generators_.end());
             coefficients_.insert(coefficients_.end(), other.coefficients_.begin(), other.coefficients_.end());
             is_normalized_ = false;
@@ -164,6 +189,8 @@ namespace algebra {
 
         friend WolnyModul operator-(const WolnyModul& operand) {
             WolnyModul result;
+            ALGEBRA_COUNT_ALLOCATION(result.generators_, operand.generators_.size());
+            ALGEBRA_COUNT_ALLOCATION(result.coefficients_, operand.coefficients_.size());
             result.generators_ = operand.generators_;
             result.coefficients_.reserve(operand.coefficients_.size());
             for (const auto& coeff : operand.coefficients_) {
@@ -175,6 +202,8 @@ namespace algebra {
 
         friend WolnyModul operator*(int scalar, const WolnyModul& operand) {
             WolnyModul result;
+            ALGEBRA_COUNT_ALLOCATION(result.generators_, operand.generators_.size());
+            ALGEBRA_COUNT_ALLOCATION(result.coefficients_, operand.coefficients_.size());
             result.generators_ = operand.generators_;
             result.coefficients_.reserve(operand.coefficients_.size());
             for (const auto& coeff : operand.coefficients_) {
@@ -2,6 +2,7 @@
 #ifndef ZMOD_H
 #define ZMOD_H
 #include <iostream>
+#include <stdexcept>
 
 namespace algebra {
     template<unsigned p>
@@ -77,6 +78,27 @@ namespace algebra {
             return ZMod(static_cast<int>(p - x.value_));
         }
 
+        // Multiplicative inverse (requires p prime)
+        ZMod inverse() const {
+            if (value_ == 0) {
+                throw std::domain_error("Zero has no multiplicative inverse");
+            }
+            long long a = value_, b = p, x0 = 1, x1 = 0;
+            while (b != 0) {
+                long long q = a / b;
+                long long t = a - q * b; a = b; b = t;
+                t = x0 - q * x1; x0 = x1; x1 = t;
+            }
+            if (a != 1) {
+                throw std::domain_error("Element is not invertible");
+            }
+            x0 %= static_cast<long long>(p);
+            if (x0 < 0) {
+                x0 += p;
+            }
+            return ZMod(static_cast<int>(x0));
+        }
+
         // Stream operator
         friend std::ostream& operator<<(std::ostream& out, const ZMod& x) {
             out << static_cast<int>(x.value_);
@@ -0,0 +1,413 @@
+//Antoni Antoszek
+// Benchmarks of the ZMod, Sympleks, WolnyModul and Kompleks hot paths.
+// Results are printed as JSON so runs on different commits can be compared.
+//
+// Usage: benchmarks [--filter <substring>] [--min-time <ms>] [--output <file>]
+//                   [--instrumentation <file>]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Homologia.h"
+#include "../HomologiaZewnetrzna.h"
+#include "../Instrumentacja.h"
+#include "../Kompleks.h"
+
+using namespace algebra;
+
+namespace {
+    struct Wynik {
+        std::string name;
+        std::size_t size;
+        std::size_t iterations;
+        double ns_per_op;
+        double ns_per_op_min;
+    };
+
+#if defined(__VERSION__)
+    const char* const COMPILER = __VERSION__;
+#else
+    const char* const COMPILER = "unknown";
+#endif
+
+    struct Ustawienia {
+        std::string filter;
+        double min_time_ms = 100.0;
+        std::string output;
+        std::string instrumentation;
+    };
+
+#if !defined(__GNUC__)
+    volatile const void* sink = nullptr;
+#endif
+
+    // Keeps the optimizer from discarding a computed value or hoisting it out of the loop
+    template<class T>
+    void keep(const T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    class Zestaw {
+    private:
+        Ustawienia settings_;
+        std::vector<Wynik> results_;
+
+        static double measure(const std::function<void()>& body, std::size_t iterations) {
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                body();
+            }
+            auto stop = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(stop - start).count();
+        }
+
+    public:
+        explicit Zestaw(Ustawienia settings) : settings_(std::move(settings)) {}
+
+        bool enabled(const std::string& name) const {
+            return settings_.filter.empty() || name.find(settings_.filter) != std::string::npos;
+        }
+
+        // Runs `body` (which performs `ops` operations) until min_time is reached, five times
+        void run(const std::string& name, std::size_t size, std::size_t ops, const std::function<void()>& body) {
+            if (!enabled(name)) {
+                return;
+            }
+            std::size_t iterations = 1;
+            double budget_ns = settings_.min_time_ms * 1e6 / 5;
+            while (true) {
+                double elapsed = measure(body, iterations);
+                if (elapsed >= budget_ns || iterations >= (std::size_t(1) << 30)) {
+                    break;
+                }
+                double scale = elapsed > 0 ? budget_ns / elapsed : 10.0;
+                iterations = std::max(iterations + 1, static_cast<std::size_t>(iterations * std::min(scale * 1.2, 10.0)));
+            }
+
+            std::vector<double> samples;
+            for (int repeat = 0; repeat < 5; ++repeat) {
+                samples.push_back(measure(body, iterations) / (static_cast<double>(iterations) * ops));
+            }
+            std::sort(samples.begin(), samples.end());
+            results_.push_back({name, size, iterations, samples[samples.size() / 2], samples.front()});
+            std::cerr << name << " [" << size << "]: " << samples[samples.size() / 2] << " ns/op\n";
+        }
+
+        void write(std::ostream& out) const {
+            out << "{\n  \"context\": {\"compiler\": \"" << COMPILER << "\", \"min_time_ms\": "
+                << settings_.min_time_ms << "},\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results_.size(); ++i) {
+                const Wynik& result = results_[i];
+                out << "    {\"name\": \"" << result.name << "\", \"size\": " << result.size
+                    << ", \"iterations\": " << result.iterations
+                    << ", \"ns_per_op\": " << result.ns_per_op
+                    << ", \"ns_per_op_min\": " << result.ns_per_op_min << "}"
+                    << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+            out << "  ]\n}\n";
+        }
+    };
+
+    // Synthetic complexes: lists of triangles as sorted vertex triples
+    using Trojkaty = std::vector<std::vector<int>>;
+
+    // Latitude/longitude triangulation of S^2 with the given number of rings and sectors
+    Trojkaty sphere(int rings, int sectors) {
+        Trojkaty triangles;
+        const int north = 0, south = 1 + (rings - 1) * sectors;
+        auto id = [sectors](int ring, int sector) { return 1 + (ring - 1) * sectors + (sector % sectors); };
+        for (int s = 0; s < sectors; ++s) {
+            triangles.push_back({north, id(1, s), id(1, s + 1)});
+            triangles.push_back({south, id(rings - 1, s), id(rings - 1, s + 1)});
+            for (int r = 1; r + 1 < rings; ++r) {
+                triangles.push_back({id(r, s), id(r, s + 1), id(r + 1, s + 1)});
+                triangles.push_back({id(r, s), id(r + 1, s), id(r + 1, s + 1)});
+            }
+        }
+        for (auto& triangle : triangles) {
+            std::sort(triangle.begin(), triangle.end());
+        }
+        return triangles;
+    }
+
+    Trojkaty torus(int n) {
+        Trojkaty triangles;
+        auto id = [n](int i, int j) { return (i % n) * n + (j % n); };
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                triangles.push_back({id(i, j), id(i + 1, j), id(i + 1, j + 1)});
+                triangles.push_back({id(i, j), id(i, j + 1), id(i + 1, j + 1)});
+            }
+        }
+        for (auto& triangle : triangles) {
+            std::sort(triangle.begin(), triangle.end());
+        }
+        return triangles;
+    }
+
+    // Vietoris-Rips 2-skeleton of random points in the unit square
+    Trojkaty rips(int points, double radius, unsigned seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<std::pair<double, double>> coordinates(points);
+        for (auto& point : coordinates) {
+            point = {uniform(generator), uniform(generator)};
+        }
+        std::vector<std::vector<int>> neighbours(points);
+        for (int a = 0; a < points; ++a) {
+            for (int b = a + 1; b < points; ++b) {
+                double dx = coordinates[a].first - coordinates[b].first;
+                double dy = coordinates[a].second - coordinates[b].second;
+                if (dx * dx + dy * dy < radius * radius) {
+                    neighbours[a].push_back(b);
+                }
+            }
+        }
+        Trojkaty triangles;
+        for (int a = 0; a < points; ++a) {
+            for (int b : neighbours[a]) {
+                for (int c : neighbours[b]) {
+                    if (std::binary_search(neighbours[a].begin(), neighbours[a].end(), c)) {
+                        triangles.push_back({a, b, c});
+                    }
+                }
+            }
+        }
+        return triangles;
+    }
+
+    template<unsigned p>
+    Kompleks<int, 3, p> chain(const Trojkaty& triangles) {
+        std::vector<Sympleks<int, 3>> generators;
+        for (const auto& triangle : triangles) {
+            generators.push_back(Sympleks<int, 3>(triangle.data()));
+        }
+        return Kompleks<int, 3, p>(generators, std::vector<ZMod<p>>(generators.size(), ZMod<p>(1)));
+    }
+
+    Filtracja<int> filtration(const Trojkaty& triangles) {
+        Filtracja<int> result;
+        for (const auto& triangle : triangles) {
+            result.addClosure(triangle);
+        }
+        return result;
+    }
+
+    template<unsigned p>
+    void zmod(Zestaw& suite, const std::string& label) {
+        const std::size_t n = 4096;
+        std::mt19937 generator(7);
+        std::vector<ZMod<p>> values;
+        for (std::size_t i = 0; i < n; ++i) {
+            values.push_back(ZMod<p>(static_cast<int>(generator() % p)));
+        }
+
+        suite.run("ZMod<" + label + ">::operator+", n, n, [&]() {
+            ZMod<p> sum;
+            for (const auto& value : values) {
+                sum = sum + value;
+            }
+            keep(sum);
+        });
+        suite.run("ZMod<" + label + ">::operator*", n, n, [&]() {
+            ZMod<p> product(1);
+            for (const auto& value : values) {
+                product = product * (value == 0 ? ZMod<p>(1) : value);
+            }
+            keep(product);
+        });
+        suite.run("ZMod<" + label + ">::operator-", n, n, [&]() {
+            ZMod<p> sum;
+            for (const auto& value : values) {
+                sum = sum + -value;
+            }
+            keep(sum);
+        });
+        suite.run("ZMod<" + label + ">::inverse", n, n, [&]() {
+            ZMod<p> sum;
+            for (const auto& value : values) {
+                if (value != 0) {
+                    sum = sum + value.inverse();
+                }
+            }
+            keep(sum);
+        });
+    }
+
+    void sympleks(Zestaw& suite) {
+        const std::size_t n = 4096;
+        std::mt19937 generator(11);
+        std::vector<int> raw(4 * n);
+        for (auto& vertex : raw) {
+            vertex = static_cast<int>(generator() % 1000);
+        }
+        std::vector<Sympleks<int, 4>> simplices;
+        for (std::size_t i = 0; i < n; ++i) {
+            simplices.push_back(Sympleks<int, 4>(&raw[4 * i]));
+        }
+
+        suite.run("Sympleks::construct", n, n, [&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                Sympleks<int, 4> simplex(&raw[4 * i]);
+                keep(simplex);
+            }
+        });
+        suite.run("Sympleks::operator<", n, n - 1, [&]() {
+            std::size_t less = 0;
+            for (std::size_t i = 1; i < n; ++i) {
+                less += simplices[i - 1] < simplices[i];
+            }
+            keep(less);
+        });
+        suite.run("Sympleks::operator==", n, n - 1, [&]() {
+            std::size_t equal = 0;
+            for (std::size_t i = 1; i < n; ++i) {
+                equal += simplices[i - 1] == simplices[i];
+            }
+            keep(equal);
+        });
+        suite.run("Sympleks::sort", n, n, [&]() {
+            std::vector<Sympleks<int, 4>> copy = simplices;
+            std::sort(copy.begin(), copy.end());
+            keep(copy);
+        });
+        suite.run("Sympleks::boundary", n, n, [&]() {
+            for (const auto& simplex : simplices) {
+                auto boundary = simplex.boundary();
+                keep(boundary.getGenerators().size());
+            }
+        });
+    }
+
+    void wolnyModul(Zestaw& suite) {
+        using Modul = WolnyModul<Sympleks<int, 3>, 5>;
+        for (std::size_t n : {100, 1000, 10000, 100000}) {
+            std::mt19937 generator(13);
+            std::vector<Sympleks<int, 3>> generators;
+            std::vector<ZMod<5>> coefficients;
+            for (std::size_t i = 0; i < n; ++i) {
+                int vertices[3] = {static_cast<int>(generator() % 200), static_cast<int>(generator() % 200),
+                                   static_cast<int>(generator() % 200)};
+                generators.push_back(Sympleks<int, 3>(vertices));
+                coefficients.push_back(ZMod<5>(static_cast<int>(generator() % 5)));
+            }
+            Modul module(generators, coefficients);
+            Modul other(generators, coefficients);
+            module.getGenerators();
+
+            suite.run("WolnyModul::normalize", n, n, [&]() {
+                Modul copy(generators, coefficients);
+                keep(copy.getGenerators().size());
+            });
+            suite.run("WolnyModul::operator+=", n, n, [&]() {
+                Modul sum = module;
+                sum += other;
+                keep(sum.getGenerators().size());
+            });
+            const std::size_t queries = 16;
+            suite.run("WolnyModul::getCoefficient", n, queries, [&]() {
+                int total = 0;
+                for (std::size_t i = 0; i < queries; ++i) {
+                    total += module.getCoefficient(generators[(i * 7919) % n]);
+                }
+                keep(total);
+            });
+        }
+    }
+
+    void kompleks(Zestaw& suite) {
+        struct Przypadek {
+            std::string name;
+            Trojkaty triangles;
+        };
+        std::vector<Przypadek> cases = {
+            {"sphere", sphere(16, 32)}, {"sphere", sphere(64, 128)},
+            {"torus", torus(32)}, {"torus", torus(128)},
+            {"rips", rips(400, 0.08, 1)}, {"rips", rips(1500, 0.05, 2)},
+        };
+        for (const auto& item : cases) {
+            Kompleks<int, 3, 2> mod2 = chain<2>(item.triangles);
+            Kompleks<int, 3, 7> mod7 = chain<7>(item.triangles);
+            mod2.getGenerators();
+            mod7.getGenerators();
+            std::size_t n = item.triangles.size();
+
+            suite.run("Kompleks::boundary<2>/" + item.name, n, n, [&]() {
+                keep(mod2.boundary().getGenerators().size());
+            });
+            suite.run("Kompleks::boundary<7>/" + item.name, n, n, [&]() {
+                keep(mod7.boundary().getGenerators().size());
+            });
+
+            Filtracja<int> complex = filtration(item.triangles);
+            suite.run("Homologia<2>/" + item.name, complex.size(), complex.size(), [&]() {
+                Homologia<int, 2> homology(complex);
+                keep(homology.getBettiNumbers());
+            });
+            suite.run("HomologiaZewnetrzna<2>/" + item.name, complex.size(), complex.size(), [&]() {
+                HomologiaZewnetrzna<int, 2> homology(complex, std::size_t(1) << 20);
+                keep(homology.getBettiNumbers());
+            });
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Ustawienia settings;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--filter" && i + 1 < argc) {
+            settings.filter = argv[++i];
+        } else if (argument == "--min-time" && i + 1 < argc) {
+            settings.min_time_ms = std::atof(argv[++i]);
+        } else if (argument == "--output" && i + 1 < argc) {
+            settings.output = argv[++i];
+        } else if (argument == "--instrumentation" && i + 1 < argc) {
+            settings.instrumentation = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <ms>] [--output <file>]"
+                      << " [--instrumentation <file>]\n";
+            return 1;
+        }
+    }
+
+    Zestaw suite(settings);
+    zmod<7>(suite, "7");
+    zmod<65521>(suite, "65521");
+    sympleks(suite);
+    wolnyModul(suite);
+    kompleks(suite);
+
+    if (settings.output.empty()) {
+        suite.write(std::cout);
+    } else {
+        std::ofstream out(settings.output);
+        if (!out) {
+            std::cerr << "Cannot open " << settings.output << "\n";
+            return 1;
+        }
+        suite.write(out);
+    }
+
+    // Counters accumulated over all runs (build with -DALGEBRA_INSTRUMENTATION=ON)
+    if (!settings.instrumentation.empty()) {
+        std::ofstream out(settings.instrumentation);
+        if (!out) {
+            std::cerr << "Cannot open " << settings.instrumentation << "\n";
+            return 1;
+        }
+        instrumentacja::dump(out);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+//Antoni Antoszek
+#ifndef STERTA_H
+#define STERTA_H
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new and delete to track the heap of a test binary.
+// Include from exactly one translation unit.
+namespace sterta {
+    struct Stan {
+        std::size_t allocations = 0;
+        std::size_t live = 0;
+        std::size_t peak = 0;
+    };
+
+    inline Stan& stan() {
+        static Stan state;
+        return state;
+    }
+
+    // Starts a new measurement: the peak is reset to the bytes live now, which are returned
+    inline std::size_t mark() {
+        stan().peak = stan().live;
+        return stan().live;
+    }
+
+    inline std::size_t allocations() { return stan().allocations; }
+    inline std::size_t live() { return stan().live; }
+    inline std::size_t peak() { return stan().peak; }
+
+    // Each block is prefixed with its size, padded to keep the payload aligned
+    constexpr std::size_t HEADER = alignof(std::max_align_t);
+}
+
+// Kept out of line so the compiler does not pair the header arithmetic with
+// known allocation sites and report false mismatches
+#if defined(__GNUC__)
+#define STERTA_NOINLINE __attribute__((noinline))
+#else
+#define STERTA_NOINLINE
+#endif
+
+STERTA_NOINLINE void* operator new(std::size_t bytes) {
+    void* block = std::malloc(bytes + sterta::HEADER);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = bytes;
+    sterta::Stan& state = sterta::stan();
+    ++state.allocations;
+    state.live += bytes;
+    if (state.live > state.peak) {
+        state.peak = state.live;
+    }
+    return static_cast<char*>(block) + sterta::HEADER;
+}
+
+STERTA_NOINLINE void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(pointer) - sterta::HEADER;
+    sterta::stan().live -= *reinterpret_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+#endif //STERTA_H
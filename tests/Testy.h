@@ -0,0 +1,77 @@
+//Antoni Antoszek
+#ifndef TESTY_H
+#define TESTY_H
+#include <exception>
+#include <iostream>
+#include <vector>
+#include "Filtracja.h"
+
+// Minimal checks that stay active in release builds
+namespace testy {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline int result() {
+        if (failures() != 0) {
+            std::cerr << failures() << " check(s) failed\n";
+            return 1;
+        }
+        return 0;
+    }
+}
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            ++::testy::failures();                                                \
+        }                                                                         \
+    } while (0)
+
+#define CHECK_THROWS(expression, exception)                                       \
+    do {                                                                          \
+        bool thrown = false;                                                      \
+        try {                                                                     \
+            expression;                                                           \
+        } catch (const exception&) {                                              \
+            thrown = true;                                                        \
+        }                                                                         \
+        if (!thrown) {                                                            \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": " #expression " did not throw " #exception "\n"; \
+            ++::testy::failures();                                                \
+        }                                                                         \
+    } while (0)
+
+namespace testy {
+    // n x n grid torus, two triangles per square
+    inline algebra::Filtracja<int> torus(int n) {
+        algebra::Filtracja<int> result;
+        auto id = [n](int i, int j) { return (i % n) * n + (j % n); };
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                result.addClosure({id(i, j), id(i + 1, j), id(i + 1, j + 1)});
+                result.addClosure({id(i, j), id(i, j + 1), id(i + 1, j + 1)});
+            }
+        }
+        return result;
+    }
+
+    // Boundary of the d-simplex on vertices 0..d, a (d-1)-sphere
+    inline algebra::Filtracja<int> sphere(int d) {
+        algebra::Filtracja<int> result;
+        for (int skip = 0; skip <= d; ++skip) {
+            std::vector<int> face;
+            for (int v = 0; v <= d; ++v) {
+                if (v != skip) {
+                    face.push_back(v);
+                }
+            }
+            result.addClosure(face);
+        }
+        return result;
+    }
+}
+
+#endif //TESTY_H
@@ -0,0 +1,106 @@
+//Antoni Antoszek
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "Homologia.h"
+#include "HomologiaPrzyrostowa.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    // Incremental Betti numbers must match a full reduction of the same filtration
+    template<unsigned p>
+    void compare(const HomologiaPrzyrostowa<int, p>& incremental) {
+        Homologia<int, p> full(incremental.getFiltration());
+        unsigned dimensions = static_cast<unsigned>(std::max(incremental.getBettiNumbers().size(),
+                                                             full.getBettiNumbers().size()));
+        for (unsigned k = 0; k <= dimensions; ++k) {
+            CHECK(incremental.getBettiNumber(k) == full.getBettiNumber(k));
+        }
+    }
+
+    // Vietoris-Rips 3-skeleton of random points in the unit square, ordered by
+    // diameter, so every prefix is the complex at a growing radius
+    std::vector<std::vector<int>> rips(int points, unsigned seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        std::vector<double> x(points), y(points);
+        for (int i = 0; i < points; ++i) {
+            x[i] = coordinate(generator);
+            y[i] = coordinate(generator);
+        }
+        auto distance = [&x, &y](int a, int b) { return std::hypot(x[a] - x[b], y[a] - y[b]); };
+
+        std::vector<std::tuple<double, std::size_t, std::vector<int>>> simplices;
+        for (int a = 0; a < points; ++a) {
+            simplices.emplace_back(0.0, 1, std::vector<int>{a});
+            for (int b = a + 1; b < points; ++b) {
+                double ab = distance(a, b);
+                simplices.emplace_back(ab, 2, std::vector<int>{a, b});
+                for (int c = b + 1; c < points; ++c) {
+                    double abc = std::max({ab, distance(a, c), distance(b, c)});
+                    simplices.emplace_back(abc, 3, std::vector<int>{a, b, c});
+                    for (int d = c + 1; d < points; ++d) {
+                        double abcd = std::max({abc, distance(a, d), distance(b, d), distance(c, d)});
+                        simplices.emplace_back(abcd, 4, std::vector<int>{a, b, c, d});
+                    }
+                }
+            }
+        }
+        std::sort(simplices.begin(), simplices.end());
+
+        std::vector<std::vector<int>> result;
+        for (const auto& simplex : simplices) {
+            result.push_back(std::get<2>(simplex));
+        }
+        return result;
+    }
+}
+
+int main() {
+    // Random Rips complexes, compared at increasing radii
+    for (unsigned seed : {1u, 2u}) {
+        std::vector<std::vector<int>> simplices = rips(16, seed);
+        HomologiaPrzyrostowa<int, 2> mod2;
+        HomologiaPrzyrostowa<int, 3> mod3;
+        for (std::size_t i = 0; i < simplices.size(); ++i) {
+            mod2.addSimplex(simplices[i]);
+            mod3.addSimplex(simplices[i]);
+            if ((i + 1) % 250 == 0 || i + 1 == simplices.size()) {
+                compare(mod2);
+                compare(mod3);
+            }
+        }
+        // The full 3-skeleton on 16 vertices has b3 = C(15, 4)
+        CHECK(mod2.getBettiNumbers() == std::vector<unsigned>({1, 0, 0, 1365}));
+    }
+
+    // Torus and sphere built one closure at a time
+    Filtracja<int> torus = testy::torus(6);
+    HomologiaPrzyrostowa<int, 3> growing_torus;
+    for (std::size_t j = 0; j < torus.size(); ++j) {
+        if (torus.getDimension(j) == 2) {
+            growing_torus.addClosure(torus.getSimplex(j));
+            compare(growing_torus);
+        }
+    }
+    CHECK(growing_torus.getBettiNumbers() == std::vector<unsigned>({1, 2, 1}));
+
+    HomologiaPrzyrostowa<int, 5> sphere(testy::sphere(4));
+    compare(sphere);
+    CHECK(sphere.getBettiNumbers() == std::vector<unsigned>({1, 0, 0, 1}));
+    sphere.addSimplex({0, 1, 2, 3, 4});
+    compare(sphere);
+    CHECK(sphere.getBettiNumbers() == std::vector<unsigned>({1, 0, 0, 0, 0}));
+
+    // Faces must be added before the simplex
+    HomologiaPrzyrostowa<int, 2> missing;
+    missing.addSimplex({0});
+    CHECK_THROWS(missing.addSimplex({0, 1}), std::invalid_argument);
+
+    return testy::result();
+}
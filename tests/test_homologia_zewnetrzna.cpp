@@ -0,0 +1,130 @@
+//Antoni Antoszek
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Homologia.h"
+#include "HomologiaZewnetrzna.h"
+#include "Sterta.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    // n x n grid torus streamed column by column with face indices computed on the fly:
+    // vertices, then three edges per vertex (horizontal, vertical, diagonal), then
+    // two triangles per square, so no part of the complex is ever stored and the
+    // only allocations are the exact-size buffers of the column handed over
+    template<unsigned p>
+    typename HomologiaZewnetrzna<int, p>::ZrodloKolumn streamedTorus(std::size_t n) {
+        std::size_t next = 0;
+        return [n, next](KolumnaRzadka<p>& column, unsigned& dimension) mutable {
+            const std::size_t vertices = n * n, edges = 3 * vertices, triangles = 2 * vertices;
+            auto id = [n](std::size_t i, std::size_t j) { return (i % n) * n + (j % n); };
+            auto edge = [vertices](std::size_t vertex, std::size_t kind) { return vertices + 3 * vertex + kind; };
+            if (next == vertices + edges + triangles) {
+                return false;
+            }
+
+            std::array<std::pair<std::size_t, int>, 3> entries{};
+            std::size_t count = 0;
+            if (next < vertices) {
+                dimension = 0;
+            } else if (next < vertices + edges) {
+                dimension = 1;
+                std::size_t vertex = (next - vertices) / 3, kind = (next - vertices) % 3;
+                std::size_t i = vertex / n, j = vertex % n;
+                std::size_t end = kind == 0 ? id(i, j + 1) : kind == 1 ? id(i + 1, j) : id(i + 1, j + 1);
+                entries = {{{vertex, -1}, {end, 1}}};
+                count = 2;
+            } else {
+                dimension = 2;
+                std::size_t square = (next - vertices - edges) / 2;
+                std::size_t i = square / n, j = square % n;
+                if ((next - vertices - edges) % 2 == 0) {
+                    // [(i,j), (i+1,j), (i+1,j+1)]
+                    entries = {{{edge(id(i + 1, j), 0), 1}, {edge(square, 2), -1}, {edge(square, 1), 1}}};
+                } else {
+                    // [(i,j), (i,j+1), (i+1,j+1)]
+                    entries = {{{edge(id(i, j + 1), 1), 1}, {edge(square, 2), -1}, {edge(square, 0), 1}}};
+                }
+                count = 3;
+            }
+            std::sort(entries.begin(), entries.begin() + count);
+            std::vector<std::size_t> rows(count);
+            std::vector<ZMod<p>> values(count);
+            for (std::size_t k = 0; k < count; ++k) {
+                rows[k] = entries[k].first;
+                values[k] = ZMod<p>(entries[k].second);
+            }
+            column = KolumnaRzadka<p>(std::move(rows), std::move(values));
+            ++next;
+            return true;
+        };
+    }
+
+    // Out-of-core reduction must spill more than one block and produce exactly the
+    // in-memory reduced matrix
+    template<unsigned p>
+    void compare(const Filtracja<int>& filtration, std::size_t budget) {
+        Homologia<int, p> memory(filtration);
+        HomologiaZewnetrzna<int, p> disk(filtration, budget);
+
+        CHECK(disk.getBlockCount() > 1);
+        CHECK(disk.getBettiNumbers() == memory.getBettiNumbers());
+        CHECK(disk.size() == filtration.size());
+        for (std::size_t j = 0; j < filtration.size(); ++j) {
+            CHECK(disk.getColumn(j) == memory.getReducedMatrix().getColumn(j));
+        }
+    }
+}
+
+int main() {
+    Filtracja<int> torus = testy::torus(12);
+    Filtracja<int> sphere = testy::sphere(5);
+
+    for (std::size_t budget : {2048, 4096, 8192}) {
+        compare<2>(torus, budget);
+        compare<3>(torus, budget);
+        compare<5>(sphere, budget);
+    }
+
+    Homologia<int, 3> torus_homology(torus);
+    CHECK(torus_homology.getBettiNumbers() == std::vector<unsigned>({1, 2, 1}));
+    Homologia<int, 2> sphere_homology(sphere);
+    CHECK(sphere_homology.getBettiNumbers() == std::vector<unsigned>({1, 0, 0, 0, 1}));
+
+    // With a streaming source the real heap, measured by the counting operator new,
+    // stays within the budget, and the engine's own accounting never undercounts it
+    const std::vector<std::pair<std::size_t, std::size_t>> runs = {
+        {8, 2048}, {8, 4096}, {8, 16384}, {40, 4096}, {40, 16384}, {40, 65536}};
+    for (const auto& run : runs) {
+        std::size_t n = run.first, budget = run.second;
+        auto source = streamedTorus<3>(n);
+        std::size_t before = sterta::mark();
+        HomologiaZewnetrzna<int, 3> streamed(source, budget);
+        std::size_t peak = sterta::peak() - before;
+        CHECK(peak <= budget);
+        CHECK(peak <= streamed.getPeakMemoryUsage());
+        CHECK(streamed.getBettiNumbers() == std::vector<unsigned>({1, 2, 1}));
+        CHECK(streamed.size() == 6 * n * n);
+        CHECK(streamed.getBlockCount() > 1);
+    }
+    HomologiaZewnetrzna<int, 3> streamed(streamedTorus<3>(12), 4096);
+    CHECK(streamed.getBettiNumbers() == torus_homology.getBettiNumbers());
+
+    // A source referring to later simplices is rejected
+    auto invalid = [](KolumnaRzadka<3>& column, unsigned& dimension) {
+        column = KolumnaRzadka<3>({0, 1}, {ZMod<3>(1), ZMod<3>(2)});
+        dimension = 1;
+        return true;
+    };
+    CHECK_THROWS((HomologiaZewnetrzna<int, 3>(invalid, 4096)), std::invalid_argument);
+
+    // A budget that cannot hold a single column is rejected
+    CHECK_THROWS((HomologiaZewnetrzna<int, 3>(torus, 300)), std::length_error);
+    CHECK_THROWS((HomologiaZewnetrzna<int, 3>(torus, 0)), std::invalid_argument);
+
+    return testy::result();
+}
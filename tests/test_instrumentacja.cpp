@@ -0,0 +1,269 @@
+//Antoni Antoszek
+// Built twice: with ALGEBRA_INSTRUMENTATION, where the allocation counter must match
+// the real heap and dump() must be valid JSON, and without it, where the macros
+// must compile away
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Filtracja.h"
+#include "Kompleks.h"
+#include "Sterta.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    // Minimal JSON reader, enough to validate the instrumentation report
+    struct Json {
+        enum class Typ { Null, Bool, Number, String, Array, Object };
+        Typ type = Typ::Null;
+        bool boolean = false;
+        double number = 0;
+        std::string text;
+        std::vector<Json> items;
+        std::map<std::string, Json> members;
+
+        bool has(const std::string& key) const { return members.count(key) != 0; }
+
+        const Json& operator[](const std::string& key) const {
+            auto it = members.find(key);
+            if (it == members.end()) {
+                throw std::runtime_error("Missing key " + key);
+            }
+            return it->second;
+        }
+    };
+
+    class Parser {
+    private:
+        const std::string& input_;
+        std::size_t position_ = 0;
+
+        void skip() {
+            while (position_ < input_.size() && std::isspace(static_cast<unsigned char>(input_[position_]))) {
+                ++position_;
+            }
+        }
+
+        void expect(char c) {
+            skip();
+            if (position_ >= input_.size() || input_[position_] != c) {
+                throw std::runtime_error(std::string("Expected ") + c);
+            }
+            ++position_;
+        }
+
+        bool accept(char c) {
+            skip();
+            if (position_ < input_.size() && input_[position_] == c) {
+                ++position_;
+                return true;
+            }
+            return false;
+        }
+
+        void keyword(const char* word) {
+            for (const char* c = word; *c != '\0'; ++c) {
+                if (position_ >= input_.size() || input_[position_++] != *c) {
+                    throw std::runtime_error(std::string("Expected ") + word);
+                }
+            }
+        }
+
+        std::string string() {
+            expect('"');
+            std::string result;
+            while (position_ < input_.size() && input_[position_] != '"') {
+                if (input_[position_] == '\\') {
+                    ++position_;
+                }
+                if (position_ < input_.size()) {
+                    result += input_[position_++];
+                }
+            }
+            expect('"');
+            return result;
+        }
+
+        Json value() {
+            Json result;
+            skip();
+            if (position_ >= input_.size()) {
+                throw std::runtime_error("Unexpected end of input");
+            }
+            char c = input_[position_];
+            if (c == '{') {
+                result.type = Json::Typ::Object;
+                expect('{');
+                if (!accept('}')) {
+                    do {
+                        std::string key = string();
+                        expect(':');
+                        result.members[key] = value();
+                    } while (accept(','));
+                    expect('}');
+                }
+            } else if (c == '[') {
+                result.type = Json::Typ::Array;
+                expect('[');
+                if (!accept(']')) {
+                    do {
+                        result.items.push_back(value());
+                    } while (accept(','));
+                    expect(']');
+                }
+            } else if (c == '"') {
+                result.type = Json::Typ::String;
+                result.text = string();
+            } else if (c == 't' || c == 'f') {
+                result.type = Json::Typ::Bool;
+                result.boolean = c == 't';
+                keyword(c == 't' ? "true" : "false");
+            } else if (c == 'n') {
+                keyword("null");
+            } else {
+                char* end = nullptr;
+                result.type = Json::Typ::Number;
+                result.number = std::strtod(input_.c_str() + position_, &end);
+                if (end == input_.c_str() + position_) {
+                    throw std::runtime_error("Invalid value");
+                }
+                position_ = end - input_.c_str();
+            }
+            return result;
+        }
+
+    public:
+        explicit Parser(const std::string& input) : input_(input) {}
+
+        Json parse() {
+            Json result = value();
+            skip();
+            if (position_ != input_.size()) {
+                throw std::runtime_error("Trailing characters");
+            }
+            return result;
+        }
+    };
+
+    Json parse(const std::string& text) {
+        try {
+            return Parser(text).parse();
+        } catch (const std::runtime_error& error) {
+            std::cerr << "Invalid JSON (" << error.what() << "):\n" << text;
+            ++testy::failures();
+            return Json();
+        }
+    }
+
+    // Triangles of the 6 x 6 torus with varying coefficients
+    Kompleks<int, 3, 7> torusChain() {
+        Filtracja<int> torus = testy::torus(6);
+        Kompleks<int, 3, 7> chain;
+        for (std::size_t j = 0; j < torus.size(); ++j) {
+            if (torus.getDimension(j) == 2) {
+                chain.addGenerator(Sympleks<int, 3>(torus.getSimplex(j).data()), ZMod<7>(static_cast<int>(j)));
+            }
+        }
+        return chain;
+    }
+
+#ifdef ALGEBRA_INSTRUMENTATION
+    // Read from the current thread only: Rejestr::threads() copies and would allocate
+    std::uint64_t counted() {
+        return instrumentacja::current().counters[static_cast<unsigned>(instrumentacja::Licznik::Allocations)].load();
+    }
+
+    // The counter must see exactly the allocations made by operator new. The first
+    // run registers the thread and the timer names, which allocate on their own.
+    template<class F>
+    void compareAllocations(const char* name, F&& operation) {
+        operation();
+        std::uint64_t counter = counted();
+        std::size_t heap = sterta::allocations();
+        operation();
+        counter = counted() - counter;
+        heap = sterta::allocations() - heap;
+        if (counter != heap || heap == 0) {
+            std::cerr << name << ": counted " << counter << ", operator new " << heap << '\n';
+            ++testy::failures();
+        }
+    }
+#endif
+}
+
+int main() {
+    const Kompleks<int, 3, 7> chain = torusChain();
+
+#ifdef ALGEBRA_INSTRUMENTATION
+    static_assert(instrumentacja::enabled(), "Instrumentation must be compiled in");
+
+    compareAllocations("copy", [&chain]() { Kompleks<int, 3, 7> copy(chain); });
+    compareAllocations("negate", [&chain]() { Kompleks<int, 3, 7> negated = -chain; });
+    compareAllocations("scale", [&chain]() { Kompleks<int, 3, 7> scaled = 3 * chain; });
+    compareAllocations("add", [&chain]() {
+        Kompleks<int, 3, 7> sum(chain);
+        sum += chain;
+        sum += -chain;
+        sum.getGenerators();
+    });
+    compareAllocations("boundary", [&chain]() { Kompleks<int, 2, 7> edges = chain.boundary(); });
+    compareAllocations("boundary of boundary", [&chain]() {
+        Kompleks<int, 1, 7> vertices = chain.boundary().boundary();
+        CHECK(vertices.getNonZeroCount() == 0);
+    });
+    compareAllocations("unnormalized", [&chain]() {
+        Kompleks<int, 3, 7> pending = chain + 2 * chain;
+        pending = pending + (-chain);
+        pending.getNonZeroCount();
+        pending.getGenerators();
+    });
+
+    // dump() is valid JSON whose totals add up over the threads
+    instrumentacja::reset();
+    Kompleks<int, 2, 7> edges = chain.boundary();
+    Json report = parse(instrumentacja::report());
+    CHECK(report["enabled"].type == Json::Typ::Bool && report["enabled"].boolean);
+    CHECK(report["threads"].type == Json::Typ::Array && !report["threads"].items.empty());
+    const Json& total = report["total"]["counters"];
+    CHECK(total.members.size() == instrumentacja::COUNTERS);
+    for (unsigned i = 0; i < instrumentacja::COUNTERS; ++i) {
+        std::string key = instrumentacja::name(static_cast<instrumentacja::Licznik>(i));
+        double sum = 0;
+        for (const Json& thread : report["threads"].items) {
+            sum += thread["counters"][key].number;
+        }
+        CHECK(total.has(key) && total[key].number == sum);
+    }
+    CHECK(total["allocations"].number > 0);
+    CHECK(total["boundary_faces"].number == 3.0 * chain.getNonZeroCount());
+    CHECK(report["total"]["timers"]["Kompleks::boundary"]["calls"].number >= 1);
+    CHECK(report["total"]["timers"]["Kompleks::boundary"].has("nanoseconds"));
+#else
+    static_assert(!instrumentacja::enabled(), "Instrumentation must compile away");
+
+    // The macros expand to nothing: their arguments are never evaluated
+    int evaluated = 0;
+    ALGEBRA_COUNT(Allocations, ++evaluated);
+    ALGEBRA_COUNT_ALLOCATION(std::vector<int>(++evaluated), 1);
+    ALGEBRA_COUNT_BUFFER(std::vector<int>(++evaluated));
+    ALGEBRA_SCOPED_TIMER("unused");
+    CHECK(evaluated == 0);
+
+    // and the hot paths allocate nothing on the counters' behalf
+    Kompleks<int, 2, 7> edges = chain.boundary();
+    CHECK(edges.getNonZeroCount() > 0);
+
+    instrumentacja::reset();
+    Json report = parse(instrumentacja::report());
+    CHECK(report.type == Json::Typ::Object && report.members.size() == 1);
+    CHECK(report["enabled"].type == Json::Typ::Bool && !report["enabled"].boolean);
+#endif
+
+    return testy::result();
+}
@@ -0,0 +1,94 @@
+//Antoni Antoszek
+#include <map>
+#include <vector>
+#include "Homologia.h"
+#include "OdwzorowanieSympleksowe.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    template<unsigned p>
+    using Macierz = std::vector<std::vector<ZMod<p>>>;
+
+    template<unsigned p>
+    Macierz<p> matrix(const std::vector<std::vector<int>>& entries) {
+        Macierz<p> result;
+        for (const auto& row : entries) {
+            result.emplace_back();
+            for (int value : row) {
+                result.back().push_back(ZMod<p>(value));
+            }
+        }
+        return result;
+    }
+
+    // Cycle on vertices 0..n-1
+    Filtracja<int> polygon(int n) {
+        Filtracja<int> result;
+        for (int i = 0; i < n; ++i) {
+            result.addClosure({i, (i + 1) % n});
+        }
+        return result;
+    }
+
+    OdwzorowanieSympleksowe<int, int> vertexMap(int n, int (*image)(int)) {
+        OdwzorowanieSympleksowe<int, int> result;
+        for (int i = 0; i < n; ++i) {
+            result.setImage(i, image(i));
+        }
+        return result;
+    }
+
+    template<unsigned p>
+    Macierz<p> inducedH1(const OdwzorowanieSympleksowe<int, int>& map,
+                         const Filtracja<int>& source, const Filtracja<int>& target) {
+        Homologia<int, p> from(source, {1});
+        Homologia<int, p> to(target, {1});
+        return map.inducedMap(from, to, 1);
+    }
+
+    template<unsigned d, unsigned p>
+    Kompleks<int, d, p> simplex(std::vector<int> vertices) {
+        return Kompleks<int, d, p>(Sympleks<int, d>(vertices.data()));
+    }
+}
+
+int main() {
+    Filtracja<int> hexagon = polygon(6);
+    Filtracja<int> triangle = polygon(3);
+
+    // Hexagon onto triangle: wrapping twice, folding pairs, collapsing to a point
+    auto twice = vertexMap(6, [](int i) { return i % 3; });
+    auto folded = vertexMap(6, [](int i) { return i / 2; });
+    auto constant = vertexMap(6, [](int) { return 0; });
+    CHECK(inducedH1<7>(twice, hexagon, triangle) == matrix<7>({{2}}));
+    CHECK(inducedH1<7>(folded, hexagon, triangle) == matrix<7>({{1}}));
+    CHECK(inducedH1<7>(constant, hexagon, triangle) == matrix<7>({{0}}));
+    CHECK(inducedH1<2>(twice, hexagon, triangle) == matrix<2>({{0}}));
+
+    // Identity and coordinate swap of the 4 x 4 torus
+    Filtracja<int> torus = testy::torus(4);
+    auto identity = vertexMap(16, [](int v) { return v; });
+    auto swap = vertexMap(16, [](int v) { return (v % 4) * 4 + v / 4; });
+    CHECK(inducedH1<5>(identity, torus, torus) == matrix<5>({{1, 0}, {0, 1}}));
+    CHECK(inducedH1<5>(swap, torus, torus) == matrix<5>({{0, -1}, {-1, 0}}));
+
+    // pushForward is a chain map and drops degenerate simplices
+    auto chain = simplex<3, 5>({0, 1, 2}) + 2 * simplex<3, 5>({1, 2, 4}) + simplex<3, 5>({0, 3, 5});
+    for (const auto* map : {&twice, &folded, &constant}) {
+        auto image = map->pushForward(chain);
+        auto difference = image.boundary() + (-map->pushForward(chain.boundary()));
+        CHECK(difference.getNonZeroCount() == 0);
+    }
+    CHECK(constant.pushForward(chain).getNonZeroCount() == 0);
+    CHECK(folded.pushForward(simplex<2, 5>({0, 1})).getNonZeroCount() == 0);
+    CHECK(twice.pushForward(simplex<3, 5>({0, 1, 2})).getNonZeroCount() == 1);
+
+    // Reversed vertex order flips the sign
+    auto reversed = vertexMap(6, [](int i) { return 5 - i; });
+    auto edge = reversed.pushForward(simplex<2, 5>({0, 1}));
+    CHECK(edge.getCoefficient(Sympleks<int, 2>(std::vector<int>{4, 5}.data())) == 4);
+
+    return testy::result();
+}
@@ -0,0 +1,48 @@
+//Antoni Antoszek
+#include <stdexcept>
+#include <vector>
+#include "Homologia.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    // Every representative chain must be a cycle
+    template<unsigned d, unsigned p>
+    void checkCycles(const std::vector<Kompleks<int, d, p>>& cycles) {
+        for (const auto& cycle : cycles) {
+            CHECK(cycle.getNonZeroCount() > 0);
+            CHECK(cycle.boundary().getNonZeroCount() == 0);
+        }
+    }
+}
+
+int main() {
+    Filtracja<int> torus = testy::torus(8);
+
+    // Tracking H_1 costs only a small fraction of the reduction itself
+    Homologia<int, 3> plain(torus);
+    Homologia<int, 3> tracked(torus, {1});
+    CHECK(tracked.getBettiNumbers() == plain.getBettiNumbers());
+    CHECK(tracked.getPeakCycleMemoryUsage() > 0);
+    CHECK(tracked.getPeakCycleMemoryUsage() * 10 < plain.getMemoryUsage());
+
+    auto loops = tracked.getRepresentativeCycles<2>();
+    CHECK(loops.size() == 2);
+    checkCycles(loops);
+
+    // Untracked dimensions are rejected
+    CHECK_THROWS(plain.getRepresentativeCycles<2>(), std::logic_error);
+
+    Homologia<int, 2> surface(torus, {2});
+    auto fundamental = surface.getRepresentativeCycles<3>();
+    CHECK(fundamental.size() == 1);
+    checkCycles(fundamental);
+
+    Homologia<int, 5> sphere(testy::sphere(4), {3});
+    auto shell = sphere.getRepresentativeCycles<4>();
+    CHECK(shell.size() == 1);
+    checkCycles(shell);
+
+    return testy::result();
+}
@@ -0,0 +1,96 @@
+//Antoni Antoszek
+#include <cstddef>
+#include <vector>
+#include "HomologiaPrzyrostowa.h"
+#include "Triangulacje.h"
+#include "Testy.h"
+
+using namespace algebra;
+
+namespace {
+    template<class S, unsigned d, unsigned p>
+    bool equal(const Kompleks<S, d, p>& a, const Kompleks<S, d, p>& b) {
+        return (a + (-b)).getNonZeroCount() == 0;
+    }
+
+    template<unsigned d, unsigned p>
+    Kompleks<int, d, p> simplex(int first) {
+        int vertices[d];
+        for (unsigned i = 0; i < d; ++i) {
+            vertices[i] = first + static_cast<int>(i);
+        }
+        return Kompleks<int, d, p>(Sympleks<int, d>(vertices));
+    }
+
+    // Subdivision is a chain map: boundary(Sd c) == Sd(boundary c)
+    template<unsigned d, unsigned p>
+    void checkSubdivision(const Kompleks<int, d, p>& chain) {
+        auto subdivided = barycentricSubdivision(chain);
+        CHECK(subdivided.getNonZeroCount() > 0);
+        CHECK(equal(subdivided.boundary(), barycentricSubdivision(chain.boundary())));
+    }
+
+    // Leibniz rule for the Eilenberg-Zilber product of an m-vertex and an n-vertex simplex:
+    // boundary(a x b) == boundary(a) x b + (-1)^(m-1) a x boundary(b)
+    template<unsigned m, unsigned n, unsigned p>
+    void checkLeibniz() {
+        Kompleks<int, m, p> first = simplex<m, p>(0);
+        Kompleks<int, n, p> second = simplex<n, p>(10);
+        auto product = simplicialProduct(first, second);
+        IloczynSympleksowy<int, int, m, n> lattice{first.getGenerators()[0], second.getGenerators()[0]};
+        CHECK(product.getNonZeroCount() == lattice.size());
+
+        int sign = (m - 1) % 2 == 0 ? 1 : -1;
+        auto expected = simplicialProduct(first.boundary(), second)
+            + sign * simplicialProduct(first, second.boundary());
+        CHECK(equal(product.boundary(), expected));
+    }
+
+    template<class I>
+    std::size_t distance(const I& range) {
+        std::size_t count = 0;
+        for (auto it = range.begin(); it != range.end(); ++it) {
+            ++count;
+        }
+        return count;
+    }
+}
+
+int main() {
+    checkSubdivision(simplex<3, 7>(0));
+    checkSubdivision(simplex<4, 7>(0));
+    checkSubdivision(simplex<4, 2>(0));
+    checkSubdivision(simplex<4, 7>(0) + 3 * simplex<4, 7>(1));
+
+    checkLeibniz<2, 2, 7>();
+    checkLeibniz<3, 3, 7>();
+    checkLeibniz<4, 3, 7>();
+    checkLeibniz<3, 4, 5>();
+
+    // Lazy ranges yield exactly size() simplices
+    int vertices[] = {0, 1, 2, 3};
+    PodzialBarycentryczny<int, 4> subdivision{Sympleks<int, 4>(vertices)};
+    CHECK(subdivision.size() == 24);
+    CHECK(distance(subdivision) == subdivision.size());
+    IloczynSympleksowy<int, int, 4, 3> product{Sympleks<int, 4>(vertices), Sympleks<int, 3>(vertices)};
+    CHECK(product.size() == 10);
+    CHECK(distance(product) == product.size());
+
+    // Streaming into the incremental reduction: Sd of a 2-sphere and a circle x circle torus
+    HomologiaPrzyrostowa<Barycentrum<int>, 3> sphere;
+    barycentricSubdivision(simplex<4, 3>(0).boundary(),
+        [&sphere](const Sympleks<Barycentrum<int>, 3>& face, const ZMod<3>&) {
+            sphere.addClosure(face.getSequence());
+        });
+    CHECK(sphere.getBettiNumbers() == std::vector<unsigned>({1, 0, 1}));
+
+    Kompleks<int, 2, 3> circle = simplex<3, 3>(0).boundary();
+    HomologiaPrzyrostowa<Para<int, int>, 3> torus;
+    simplicialProduct(circle, circle,
+        [&torus](const Sympleks<Para<int, int>, 3>& face, const ZMod<3>&) {
+            torus.addClosure(face.getSequence());
+        });
+    CHECK(torus.getBettiNumbers() == std::vector<unsigned>({1, 2, 1}));
+
+    return testy::result();
+}